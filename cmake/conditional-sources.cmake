@@ -19,11 +19,16 @@
 
 if(NOT SUPPORT_VMEC)
   list(REMOVE_ITEM gyronimo_sources
+      ${PROJECT_SOURCE_DIR}/gyronimo/metrics/context_vmec.cc
       ${PROJECT_SOURCE_DIR}/gyronimo/metrics/metric_vmec.cc
       ${PROJECT_SOURCE_DIR}/gyronimo/parsers/parser_vmec.cc
       ${PROJECT_SOURCE_DIR}/gyronimo/metrics/morphism_vmec.cc
       ${PROJECT_SOURCE_DIR}/gyronimo/fields/equilibrium_vmec.cc)
   list(REMOVE_ITEM apps_sources
+      ${PROJECT_SOURCE_DIR}/misc/apps/ensembletrace.cc
       ${PROJECT_SOURCE_DIR}/misc/apps/vmecdump.cc
+      ${PROJECT_SOURCE_DIR}/misc/apps/vmecsnap.cc
       ${PROJECT_SOURCE_DIR}/misc/apps/vmectrace.cc)
+  list(REMOVE_ITEM tests_sources
+      ${PROJECT_SOURCE_DIR}/misc/tests/equilibrium_vmec.cc)
 endif()
@@ -24,6 +24,11 @@ message(STATUS "  library: " ${GSL_LIBRARIES})
 find_package(Boost 1.73.0 REQUIRED)
 message(STATUS "  include: " ${Boost_INCLUDE_DIRS})
 
+find_package(Threads REQUIRED)
+
+# shm_open (core/snapshot.cc) lives in librt with glibc older than 2.34:
+find_library(rt_library rt)
+
 # add libraries to provide VMEC support (ncxx4 and dependencies) if required;
 if(SUPPORT_VMEC)
   message(STATUS "Configuring VMEC support (SUPPORT_VMEC=ON)")
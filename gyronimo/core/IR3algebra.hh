@@ -144,6 +144,9 @@ class ddIR3 {
 //! Inverse of a dIR3 matrix.
 dIR3 inverse(const dIR3& m);
 
+//! Determinant of a dIR3 matrix.
+double determinant(const dIR3& m);
+
 //! Binary operation between two arbitrary types with `operator[i]`.
 /*!
     Used to build at _compile time_ Expression Templates representing an
@@ -0,0 +1,85 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @IR3span.hh, this file is part of ::gyronimo::
+
+#ifndef GYRONIMO_IR3SPAN
+#define GYRONIMO_IR3SPAN
+
+#include <gyronimo/core/IR3algebra.hh>
+#include <gyronimo/core/error.hh>
+
+#include <algorithm>
+#include <span>
+
+namespace gyronimo {
+
+//! Read-only view over a sequence of points in @f$\mathbb{R}^3@f$ (SoA layout).
+/*!
+    The coordinates `u`, `v`, and `w` of `size()` points are stored by the
+    caller in three separate contiguous arrays (structure of arrays), no data is
+    owned or copied. The `i`-th point is assembled on request by `operator[]`.
+    This is the input type of all batched evaluations (e.g.,
+    `IR3field::magnitude_batch`), whose results are written into caller-owned
+    buffers with at least `size()` elements. Large batches may be split into
+    chunks with `subspan`.
+*/
+class IR3span {
+ public:
+  IR3span(
+      std::span<const double> u, std::span<const double> v,
+      std::span<const double> w);
+  ~IR3span() {};
+
+  size_t size() const { return u_.size(); };
+  IR3 operator[](size_t i) const { return {u_[i], v_[i], w_[i]}; };
+  IR3span subspan(size_t offset, size_t count) const;
+
+  std::span<const double> u() const { return u_; };
+  std::span<const double> v() const { return v_; };
+  std::span<const double> w() const { return w_; };
+ private:
+  std::span<const double> u_, v_, w_;
+};
+
+inline IR3span::IR3span(
+    std::span<const double> u, std::span<const double> v,
+    std::span<const double> w)
+    : u_(u), v_(v), w_(w) {
+  if (v.size() != u.size() || w.size() != u.size())
+    error(__func__, __FILE__, __LINE__, "mismatched coordinate arrays.", 1);
+}
+
+//! Returns the points `[offset, offset + count)`, clipped to `size()`.
+inline IR3span IR3span::subspan(size_t offset, size_t count) const {
+  offset = std::min(offset, this->size());
+  count = std::min(count, this->size() - offset);
+  return {
+      u_.subspan(offset, count), v_.subspan(offset, count),
+      w_.subspan(offset, count)};
+}
+
+//! Aborts if a caller-owned output buffer cannot hold a whole batch.
+template<typename T>
+inline void check_batch_size(const IR3span& q, std::span<T> out) {
+  if (out.size() < q.size())
+    error(__func__, __FILE__, __LINE__, "output buffer too small.", 1);
+}
+
+}  // end namespace gyronimo.
+
+#endif  // GYRONIMO_IR3SPAN
@@ -35,4 +35,10 @@ SM3 inverse(const SM3& m) {
     ideterminant*(m[SM3::uv]*m[SM3::uv] - m[SM3::uu]*m[SM3::vv])};
 }
 
+double determinant(const SM3& m) {
+  return m[SM3::uu]*m[SM3::vv]*m[SM3::ww] +
+      2*m[SM3::uv]*m[SM3::uw]*m[SM3::vw] - m[SM3::uv]*m[SM3::uv]*m[SM3::ww] -
+      m[SM3::uu]*m[SM3::vw]*m[SM3::vw] - m[SM3::uw]*m[SM3::uw]*m[SM3::vv];
+}
+
 } // end namespace gyronimo.
@@ -63,6 +63,9 @@ class dSM3 {
 //! Inverse of a symmetric 3x3 matrix.
 SM3 inverse(const SM3& m);
 
+//! Determinant of a symmetric 3x3 matrix.
+double determinant(const SM3& m);
+
 } // end namespace gyronimo.
 
 #endif // end GYRONIMO_SM3ALGEBRA
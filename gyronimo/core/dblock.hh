@@ -20,7 +20,10 @@
 #ifndef GYRONIMO_DBLOCK
 #define GYRONIMO_DBLOCK
 
+#include <compare>
+#include <iterator>
 #include <ranges>
+#include <valarray>
 
 namespace gyronimo {
 
@@ -70,6 +73,72 @@ class dblock_adapter : public dblock {
   Range moved_in_obj_;
 };
 
+//! Non-owning **read-only** view of equally-spaced doubles.
+/*!
+    Refers to `size` doubles stored `stride` elements apart, starting at
+    `first`, with no copies involved. Typical use is a column of a row-major
+    array (e.g., a `std::slice` of a `VMEC` 2d array, one harmonic across all
+    flux surfaces), to be read in place by an `interpolator1d_factory` via
+    `interpolate_strided`. Being not necessarily contiguous, it is not a
+    `dblock`; its random-access iterators support std::ranges semantics.
+*/
+class dblock_strided {
+ public:
+  typedef size_t size_type;
+  typedef double value_type;
+  class iterator {
+   public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef double value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const double* pointer;
+    typedef const double& reference;
+    iterator() : p_(nullptr), stride_(1) {};
+    iterator(const double* p, difference_type stride)
+        : p_(p), stride_(stride) {};
+    reference operator*() const {return *p_;};
+    reference operator[](difference_type k) const {return p_[k*stride_];};
+    iterator& operator++() {p_ += stride_; return *this;};
+    iterator& operator--() {p_ -= stride_; return *this;};
+    iterator operator++(int) {iterator i = *this; ++*this; return i;};
+    iterator operator--(int) {iterator i = *this; --*this; return i;};
+    iterator& operator+=(difference_type k) {p_ += k*stride_; return *this;};
+    iterator& operator-=(difference_type k) {p_ -= k*stride_; return *this;};
+    iterator operator+(difference_type k) const {return iterator(*this) += k;};
+    iterator operator-(difference_type k) const {return iterator(*this) -= k;};
+    friend iterator operator+(difference_type k, const iterator& i) {
+        return i + k;};
+    difference_type operator-(const iterator& i) const {
+        return (p_ - i.p_)/stride_;};
+    bool operator==(const iterator& i) const {return p_ == i.p_;};
+    auto operator<=>(const iterator& i) const {return p_ <=> i.p_;};
+   private:
+    const double* p_;
+    difference_type stride_;
+  };
+  typedef iterator const_iterator;
+  dblock_strided(const double* first, size_type size, size_type stride = 1)
+      : first_(first), size_(size), stride_(stride) {};
+  template<typename Range> requires
+    std::ranges::contiguous_range<Range> &&
+    std::same_as<std::ranges::range_value_t<Range>, double>
+  dblock_strided(const Range& obj, const std::slice& mask)
+      : dblock_strided(std::ranges::data(obj) + mask.start(),
+          mask.size(), mask.stride()) {}
+  iterator begin() const {return iterator(first_, stride_);};
+  iterator end() const {return this->begin() + size_;};
+  const double* data() const {return first_;};
+  size_type size() const {return size_;};
+  size_type stride() const {return stride_;};
+  bool is_contiguous() const {return stride_ == 1;};
+  value_type front() const {return first_[0];};
+  value_type back() const {return (*this)[size_ - 1];};
+  value_type operator[](size_t k) const {return first_[k*stride_];};
+ private:
+  const double* first_;
+  size_type size_, stride_;
+};
+
 } // end namespace gyronimo.
 
 #endif // GYRONIMO_DBLOCK
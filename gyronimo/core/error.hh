@@ -24,7 +24,7 @@
 
 namespace gyronimo {
 
-void warning(const char* message);
+void warning(const std::string& message);
 void error(
     const char* caller_name, const char* file_name,
     const int line_num, const std::string& message, const int exit_code);
@@ -0,0 +1,87 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @fourier_phases.cc, this file is part of ::gyronimo::
+
+#include <gyronimo/core/error.hh>
+#include <gyronimo/core/fourier_phases.hh>
+
+#include <cmath>
+#include <numeric>
+
+namespace gyronimo {
+
+//! Stores the mode numbers as multiples of their greatest common divisors.
+fourier_phases::fourier_phases(const narray_type& m, const narray_type& n)
+    : m_step_(1), n_step_(1), m_max_(0), n_max_(0),
+      m_index_(m.size()), n_index_(n.size()) {
+  if (m.size() != n.size())
+    error(__func__, __FILE__, __LINE__, " m and n size mismatch.", 1);
+  auto is_integer = [](double x) { return x == std::round(x); };
+  long m_gcd = 0, n_gcd = 0;
+  for (size_t i = 0; i < m.size(); i++) {
+    if (!is_integer(m[i]) || !is_integer(n[i]))
+      error(__func__, __FILE__, __LINE__, " non-integer mode number.", 1);
+    m_gcd = std::gcd(m_gcd, std::lround(m[i]));
+    n_gcd = std::gcd(n_gcd, std::lround(n[i]));
+  }
+  m_step_ = (m_gcd ? m_gcd : 1);
+  n_step_ = (n_gcd ? n_gcd : 1);
+  for (size_t i = 0; i < m.size(); i++) {
+    m_index_[i] = std::lround(m[i]) / std::lround(m_step_);
+    n_index_[i] = std::lround(n[i]) / std::lround(n_step_);
+    m_max_ = std::max(m_max_, (size_t)std::abs(m_index_[i]));
+    n_max_ = std::max(n_max_, (size_t)std::abs(n_index_[i]));
+  }
+}
+
+//! Fills `out` with @f$e^{i(m_k\theta - n_k\zeta)}@f$, `out.size()>=size()`.
+void fourier_phases::operator()(
+    double theta, double zeta, std::span<std::complex<double>> out) const {
+  if (out.size() < m_index_.size())
+    error(__func__, __FILE__, __LINE__, " output span too small.", 1);
+  thread_local std::vector<std::complex<double>> cis_m, cis_n;
+  build_powers(m_step_ * theta, m_max_, cis_m);
+  build_powers(-n_step_ * zeta, n_max_, cis_n);
+  for (size_t i = 0; i < m_index_.size(); i++) {
+    long mi = m_index_[i], ni = n_index_[i];
+    std::complex<double> phase_m = (mi < 0 ? std::conj(cis_m[-mi]) : cis_m[mi]);
+    std::complex<double> phase_n = (ni < 0 ? std::conj(cis_n[-ni]) : cis_n[ni]);
+    out[i] = multiply(phase_m, phase_n);
+  }
+}
+
+//! Complex product, without the inf/nan recovery of `std::complex` (unit
+//! moduli here) that keeps compilers from inlining it.
+std::complex<double> fourier_phases::multiply(
+    const std::complex<double>& a, const std::complex<double>& b) {
+  return {
+      a.real() * b.real() - a.imag() * b.imag(),
+      a.real() * b.imag() + a.imag() * b.real()};
+}
+
+//! Fills `table[j]` with @f$e^{ij\alpha}@f$, for @f$0 \le j \le@f$ `max`.
+void fourier_phases::build_powers(
+    double angle, size_t max, std::vector<std::complex<double>>& table) {
+  table.resize(max + 1);
+  table[0] = {1.0, 0.0};
+  if (max == 0) return;
+  table[1] = {std::cos(angle), std::sin(angle)};
+  for (size_t j = 2; j <= max; j++) table[j] = multiply(table[j - 1], table[1]);
+}
+
+}  // end namespace gyronimo.
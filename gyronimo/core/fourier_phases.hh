@@ -0,0 +1,67 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @fourier_phases.hh, this file is part of ::gyronimo::
+
+#ifndef GYRONIMO_FOURIER_PHASES
+#define GYRONIMO_FOURIER_PHASES
+
+#include <complex>
+#include <span>
+#include <valarray>
+#include <vector>
+
+namespace gyronimo {
+
+//! Phase factors @f$e^{i(m_k\theta - n_k\zeta)}@f$ of a set of harmonics.
+/*!
+    The mode numbers `m` and `n` of each harmonic must be integers, stored as
+    doubles (e.g., `VMEC` `xm` and `xn` arrays, the latter including the number
+    of field periods). Rather than evaluating a cosine and a sine per harmonic,
+    `operator()` builds the base tables @f$e^{i j \Delta m \theta}@f$ and
+    @f$e^{-i j \Delta n \zeta}@f$ (with @f$\Delta m@f$ and @f$\Delta n@f$ the
+    greatest common divisors of the mode numbers) by the angle-addition
+    recurrence @f$e^{i(j+1)\alpha} = e^{ij\alpha}e^{i\alpha}@f$ and multiplies
+    the relevant entries. Only two transcendental pairs are evaluated per call,
+    the rounding error growing linearly with the largest mode number, to about
+    ten times its product with the machine epsilon (i.e., @f$2\times10^{-13}@f$
+    for mode numbers around one hundred, @f$3\times10^{-12}@f$ around one
+    thousand). The base tables are per-thread scratch buffers, the object
+    itself being read-only, and `out` must hold at least `size()` elements.
+*/
+class fourier_phases {
+ public:
+  using narray_type = std::valarray<double>;
+  fourier_phases(const narray_type& m, const narray_type& n);
+  ~fourier_phases() {};
+
+  size_t size() const { return m_index_.size(); };
+  void operator()(
+      double theta, double zeta, std::span<std::complex<double>> out) const;
+ private:
+  double m_step_, n_step_;
+  size_t m_max_, n_max_;
+  std::vector<long> m_index_, n_index_;
+  static void build_powers(
+      double angle, size_t max, std::vector<std::complex<double>>& table);
+  static std::complex<double> multiply(
+      const std::complex<double>& a, const std::complex<double>& b);
+};
+
+}  // end namespace gyronimo.
+
+#endif  // GYRONIMO_FOURIER_PHASES
@@ -0,0 +1,52 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @mapped_file.cc, this file is part of ::gyronimo::
+
+#include <gyronimo/core/error.hh>
+#include <gyronimo/core/mapped_file.hh>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace gyronimo {
+
+//! Maps the whole of `name` (which must not be empty) for reading.
+mapped_file::mapped_file(const std::string& name, source_t source)
+    : data_(nullptr), size_(0) {
+  int descriptor = (source == shared_memory ?
+      ::shm_open(name.c_str(), O_RDONLY, 0) : ::open(name.c_str(), O_RDONLY));
+  if (descriptor < 0)
+    error(__func__, __FILE__, __LINE__, " cannot open " + name, 1);
+  struct stat status;
+  if (::fstat(descriptor, &status) != 0 || status.st_size == 0)
+    error(__func__, __FILE__, __LINE__, " cannot stat " + name, 1);
+  size_ = status.st_size;
+  void* address = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, descriptor, 0);
+  ::close(descriptor);  // the mapping survives the descriptor.
+  if (address == MAP_FAILED)
+    error(__func__, __FILE__, __LINE__, " cannot map " + name, 1);
+  data_ = static_cast<const std::byte*>(address);
+}
+
+mapped_file::~mapped_file() {
+  if (data_) ::munmap(const_cast<std::byte*>(data_), size_);
+}
+
+}  // end namespace gyronimo.
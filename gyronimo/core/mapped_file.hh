@@ -0,0 +1,59 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @mapped_file.hh, this file is part of ::gyronimo::
+
+#ifndef GYRONIMO_MAPPED_FILE
+#define GYRONIMO_MAPPED_FILE
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace gyronimo {
+
+//! Read-only memory mapping of a whole file.
+/*!
+    The file contents are accessed in place through `data()`, pages being read
+    by the operating system on first access and shared (via the page cache) by
+    all processes mapping the same file. With `source` set to `shared_memory`,
+    `name` refers to a POSIX shared-memory object (see `shm_open`) instead of a
+    file in the filesystem. The mapping is released on destruction,
+    invalidating every pointer into it. Aborts if the file cannot be opened or
+    mapped.
+*/
+class mapped_file {
+ public:
+  enum source_t {filesystem, shared_memory};
+  mapped_file(const std::string& name, source_t source = filesystem);
+  mapped_file(const mapped_file&) = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+  ~mapped_file();
+
+  const std::byte* data() const { return data_; };
+  size_t size() const { return size_; };
+  std::string_view text() const {
+    return {reinterpret_cast<const char*>(data_), size_};
+  };
+ private:
+  const std::byte* data_;
+  size_t size_;
+};
+
+}  // end namespace gyronimo.
+
+#endif  // GYRONIMO_MAPPED_FILE
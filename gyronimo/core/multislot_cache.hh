@@ -0,0 +1,74 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @multislot_cache.hh, this file is part of ::gyronimo::
+
+#ifndef GYRONIMO_MULTISLOT_CACHE
+#define GYRONIMO_MULTISLOT_CACHE
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <tuple>
+#include <utility>
+
+namespace gyronimo {
+
+//! Cache holding the `N` most recent `Value`s and the `Keys` they belong to.
+/*!
+    Lookups by `find` scan the slots from the most to the least recent entry
+    and return `nullptr` on a miss; `insert` overwrites the oldest slot. Keys
+    are compared with `operator==`, hence only bit-identical arguments hit.
+    Small `N` values are intended (e.g., the stages of a Runge-Kutta step).
+    The object is not thread safe, see `per_thread`.
+*/
+template<size_t N, typename Value, typename... Keys> requires (N > 0)
+class multislot_cache {
+ public:
+  multislot_cache() : next_(0) {};
+  ~multislot_cache() {};
+  const Value* find(const Keys&... keys) const;
+  const Value& insert(const Value& value, const Keys&... keys);
+ private:
+  using slot_t = std::pair<std::tuple<Keys...>, Value>;
+  std::array<std::optional<slot_t>, N> slots_;
+  size_t next_;
+};
+
+template<size_t N, typename Value, typename... Keys> requires (N > 0)
+const Value* multislot_cache<N, Value, Keys...>::find(
+    const Keys&... keys) const {
+  for (size_t k = 1; k <= N; k++) {
+    const std::optional<slot_t>& slot = slots_[(next_ + N - k) % N];
+    if (!slot) return nullptr;  // slots are filled in order.
+    if (slot->first == std::tie(keys...)) return &slot->second;
+  }
+  return nullptr;
+}
+
+template<size_t N, typename Value, typename... Keys> requires (N > 0)
+const Value& multislot_cache<N, Value, Keys...>::insert(
+    const Value& value, const Keys&... keys) {
+  std::optional<slot_t>& slot = slots_[next_];
+  slot.emplace(std::tuple<Keys...>(keys...), value);
+  next_ = (next_ + 1) % N;
+  return slot->second;
+}
+
+}  // end namespace gyronimo.
+
+#endif  // GYRONIMO_MULTISLOT_CACHE
@@ -0,0 +1,84 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @per_thread.hh, this file is part of ::gyronimo::
+
+#ifndef GYRONIMO_PER_THREAD
+#define GYRONIMO_PER_THREAD
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace gyronimo {
+
+//! Per-instance and per-thread storage of a `T` object.
+/*!
+    Each `per_thread` object owns a distinct copy of a default-constructed `T`
+    in every thread calling `local()`, which returns a reference to the calling
+    thread's copy (created on first use). This is the storage to use for mutable
+    state behind `const` member functions (e.g., caches) that must be both safe
+    for concurrent readers and private to each instance, unlike function-level
+    `thread_local` statics that are shared by all instances of the same type.
+    The copies belong to the instance and are released with it (copies of a
+    `per_thread` start empty), threads being told apart by their
+    `std::thread::id` (i.e., a new thread may inherit the copy of a finished
+    one). Each thread remembers where its copies of the last few instances used
+    are (in a small fixed-size table, indexed by a unique instance id that is
+    never reused), such that repeated calls skip the lock guarding the
+    instance's own index of copies.
+*/
+template<typename T>
+class per_thread {
+ public:
+  per_thread() : id_(next_id_++) {};
+  per_thread(const per_thread&) : id_(next_id_++) {};
+  per_thread& operator=(const per_thread&) { return *this; };
+  ~per_thread() {};
+  T& local() const;
+ private:
+  struct recent_t {
+    size_t id = -1;
+    T* copy = nullptr;
+  };
+  static constexpr size_t recent_size = 16;
+  const size_t id_;
+  mutable std::mutex mutex_;
+  mutable std::unordered_map<std::thread::id, std::unique_ptr<T>> copies_;
+  static inline std::atomic<size_t> next_id_ = 0;
+};
+
+template<typename T>
+T& per_thread<T>::local() const {
+  thread_local std::array<recent_t, recent_size> recent;
+  recent_t& r = recent[id_ % recent_size];
+  if (r.id != id_) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_ptr<T>& copy = copies_[std::this_thread::get_id()];
+    if (!copy) copy = std::make_unique<T>();
+    r = {id_, copy.get()};
+  }
+  return *r.copy;
+}
+
+}  // end namespace gyronimo.
+
+#endif  // GYRONIMO_PER_THREAD
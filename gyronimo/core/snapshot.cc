@@ -0,0 +1,303 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @snapshot.cc, this file is part of ::gyronimo::
+
+#include <gyronimo/core/error.hh>
+#include <gyronimo/core/snapshot.hh>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace gyronimo {
+
+//! Maps `filename` and indexes its sections, aborting if malformed.
+snapshot::snapshot(const std::string& filename) : file_(filename) {
+  this->index(file_.data(), file_.size(), filename);
+}
+
+//! Maps the shared-memory object `shared_name`, built by `build` if absent.
+snapshot::snapshot(
+    const std::string& shared_name, const std::function<writer()>& build,
+    double timeout)
+    : file_(attach(shared_name, build, timeout), mapped_file::shared_memory) {
+  control_t control;
+  if (file_.size() < sizeof(control))
+    error(__func__, __FILE__, __LINE__, " truncated " + shared_name, 1);
+  std::memcpy(&control, file_.data(), sizeof(control));
+  if (!std::equal(shared_magic_, shared_magic_ + 8, control.magic) ||
+      control.version != version || control.ready != 1)
+    error(__func__, __FILE__, __LINE__,
+          " incompatible " + shared_name + ", remove it first.", 1);
+  this->index(
+      file_.data() + sizeof(control), file_.size() - sizeof(control),
+      shared_name);
+}
+
+//! Removes the shared-memory object `shared_name`, if any.
+/*!
+    Processes still mapping the object keep their mappings, the memory being
+    released when the last one is gone.
+*/
+void snapshot::remove_shared(const std::string& shared_name) {
+  ::shm_unlink(shared_name.c_str());
+}
+
+//! Indexes the sections of the `size` bytes at `data`, aborting if malformed.
+void snapshot::index(
+    const std::byte* data, size_t size, const std::string& name) {
+  header_t header;
+  if (size < sizeof(header))
+    error(__func__, __FILE__, __LINE__, " truncated " + name, 1);
+  std::memcpy(&header, data, sizeof(header));
+  if (!std::equal(magic_, magic_ + 8, header.magic))
+    error(__func__, __FILE__, __LINE__, " not a snapshot: " + name, 1);
+  if (header.version != version)
+    error(__func__, __FILE__, __LINE__, " unknown version: " + name, 1);
+  if (header.bytes != size ||
+      header.sections > (header.bytes - sizeof(header)) / sizeof(entry_t))
+    error(__func__, __FILE__, __LINE__, " truncated " + name, 1);
+  for (size_t k = 0; k < header.sections; k++) {
+    entry_t entry;
+    std::memcpy(
+        &entry, data + sizeof(header) + k * sizeof(entry), sizeof(entry));
+    if (entry.offset % alignof(double) != 0 || entry.offset > header.bytes ||
+        entry.size > (header.bytes - entry.offset) / sizeof(double))
+      error(__func__, __FILE__, __LINE__, " corrupted " + name, 1);
+    std::string section(entry.name, strnlen(entry.name, sizeof(entry.name)));
+    if (!sections_.emplace(
+            section, std::span<const double>(
+                reinterpret_cast<const double*>(data + entry.offset),
+                entry.size)).second)
+      error(__func__, __FILE__, __LINE__, " repeated " + section, 1);
+  }
+}
+
+//! Shared-memory objects being filled by this process.
+snapshot::pending_t& snapshot::pending() {
+  static pending_t* p = new pending_t;  // still alive in atexit handlers.
+  return *p;
+}
+
+//! Adds `shared_name` to, or removes it from, the objects being filled.
+/*!
+    The objects still being filled when the process exits (e.g., by `error()`
+    while building) are removed by `remove_pending()`, registered with
+    `std::atexit` on the first call.
+*/
+void snapshot::set_pending(const std::string& shared_name, bool is_pending) {
+  static std::once_flag once;
+  std::call_once(once, []() { std::atexit(snapshot::remove_pending); });
+  std::lock_guard<std::mutex> lock(pending().mutex);
+  std::erase(pending().names, shared_name);
+  if (is_pending) pending().names.push_back(shared_name);
+}
+void snapshot::remove_pending() {
+  std::lock_guard<std::mutex> lock(pending().mutex);
+  for (const std::string& name : pending().names) ::shm_unlink(name.c_str());
+}
+
+//! Creates and fills `shared_name` if absent, or waits until it is ready.
+/*!
+    Creation is exclusive (`O_EXCL`), such that only one process calls `build`
+    even if many start together. Waiting processes poll the control block,
+    retrying creation if the object is gone (i.e., its creator failed) and
+    taking it over if its creator died while holding the lock.
+*/
+std::string snapshot::attach(
+    const std::string& shared_name, const std::function<writer()>& build,
+    double timeout) {
+  auto start = std::chrono::steady_clock::now();
+  while (true) {
+    int descriptor =
+        ::shm_open(shared_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (descriptor >= 0) {
+      if (::flock(descriptor, LOCK_EX) != 0) {
+        ::close(descriptor);
+        ::shm_unlink(shared_name.c_str());
+        error(__func__, __FILE__, __LINE__, " cannot lock " + shared_name, 1);
+      }
+      snapshot::fill(descriptor, shared_name, build);
+      return shared_name;
+    }
+    if (errno != EEXIST)
+      error(__func__, __FILE__, __LINE__, " cannot create " + shared_name, 1);
+    descriptor = ::shm_open(shared_name.c_str(), O_RDONLY, 0);
+    if (descriptor < 0) continue;  // removed by a failed creator, retries.
+    control_t control = {};
+    bool complete = (::pread(descriptor, &control, sizeof(control), 0) ==
+        ssize_t(sizeof(control)));
+    bool abandoned = complete && control.owner != 0 && control.ready == 0 &&
+        ::flock(descriptor, LOCK_SH | LOCK_NB) == 0;
+    ::close(descriptor);
+    if (complete && control.ready != 0) return shared_name;
+    if (abandoned && snapshot::take_over(shared_name, build))
+      return shared_name;
+    std::chrono::duration<double> waited =
+        std::chrono::steady_clock::now() - start;
+    if (waited.count() > timeout)
+      error(__func__, __FILE__, __LINE__,
+            " timeout on " + shared_name + ", remove it if stale.", 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+}
+
+//! Fills the abandoned `shared_name`, unless another process got there first.
+/*!
+    Returns false if the exclusive lock is taken (i.e., another process is
+    taking over) or the object was filled meanwhile.
+*/
+bool snapshot::take_over(
+    const std::string& shared_name, const std::function<writer()>& build) {
+  int descriptor = ::shm_open(shared_name.c_str(), O_RDWR, 0);
+  if (descriptor < 0) return false;
+  control_t control = {};
+  if (::flock(descriptor, LOCK_EX | LOCK_NB) != 0 ||
+      ::pread(descriptor, &control, sizeof(control), 0) !=
+          ssize_t(sizeof(control)) ||
+      control.ready != 0) {
+    ::close(descriptor);
+    return false;
+  }
+  warning(
+      "snapshot: creator " + std::to_string(control.owner) + " of " +
+      shared_name + " died, building it here.");
+  snapshot::fill(descriptor, shared_name, build);
+  return true;
+}
+
+//! Builds the sections into `shared_name`, whose lock is held by the caller.
+/*!
+    The control block (with this process as owner) is written first, the
+    object being resized and filled only once the sections are built and the
+    ready flag being raised last (with release semantics), after which the
+    object is never written again. Until then, the object is removed if
+    `build` or `serialise` throw (the exception being rethrown) or the process
+    exits. Closes `descriptor`, thus releasing the lock.
+*/
+void snapshot::fill(
+    int descriptor, const std::string& shared_name,
+    const std::function<writer()>& build) {
+  set_pending(shared_name, true);
+  control_t control = {};
+  std::copy(shared_magic_, shared_magic_ + 8, control.magic);
+  control.version = version;
+  control.owner = ::getpid();
+  if (::ftruncate(descriptor, sizeof(control)) != 0 ||
+      ::pwrite(descriptor, &control, sizeof(control), 0) !=
+          ssize_t(sizeof(control)))
+    error(__func__, __FILE__, __LINE__, " cannot fill " + shared_name, 1);
+  std::vector<std::byte> bytes;
+  try {
+    bytes = build().serialise();
+  } catch (...) {
+    ::shm_unlink(shared_name.c_str());
+    set_pending(shared_name, false);
+    ::close(descriptor);
+    throw;
+  }
+  size_t size = sizeof(control_t) + bytes.size();
+  void* address = MAP_FAILED;
+  if (::ftruncate(descriptor, size) == 0)
+    address = ::mmap(
+        nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+  if (address == MAP_FAILED)
+    error(__func__, __FILE__, __LINE__, " cannot fill " + shared_name, 1);
+  control_t* mapped = static_cast<control_t*>(address);
+  std::memcpy(mapped + 1, bytes.data(), bytes.size());
+  std::atomic_ref<uint64_t>(mapped->ready).store(1, std::memory_order_release);
+  ::munmap(address, size);
+  set_pending(shared_name, false);
+  ::close(descriptor);
+}
+
+bool snapshot::contains(const std::string& name) const {
+  return sections_.contains(name);
+}
+
+//! Returns the section `name` in place, aborting if there is none.
+std::span<const double> snapshot::operator[](const std::string& name) const {
+  auto section = sections_.find(name);
+  if (section == sections_.end())
+    error(__func__, __FILE__, __LINE__, " no section " + name, 1);
+  return section->second;
+}
+
+//! Adds a copy of `data` as the section `name`, which must be new.
+void snapshot::writer::add(
+    const std::string& name, std::span<const double> data) {
+  if (name.size() >= sizeof(entry_t::name))
+    error(__func__, __FILE__, __LINE__, " name too long: " + name, 1);
+  for (const auto& section : sections_)
+    if (section.first == name)
+      error(__func__, __FILE__, __LINE__, " repeated section " + name, 1);
+  sections_.emplace_back(name, std::vector<double>(data.begin(), data.end()));
+}
+void snapshot::writer::add(const std::string& name, double value) {
+  this->add(name, std::span<const double>(&value, 1));
+}
+
+//! Returns the bytes of the `snapshot` file holding all sections added.
+std::vector<std::byte> snapshot::writer::serialise() const {
+  header_t header;
+  std::copy(magic_, magic_ + 8, header.magic);
+  header.version = version;
+  header.sections = sections_.size();
+  header.bytes = sizeof(header) + sections_.size() * sizeof(entry_t);
+  std::vector<entry_t> entries(sections_.size());
+  for (size_t k = 0; k < sections_.size(); k++) {
+    std::memset(entries[k].name, 0, sizeof(entries[k].name));
+    sections_[k].first.copy(entries[k].name, sizeof(entries[k].name) - 1);
+    entries[k].offset = header.bytes;
+    entries[k].size = sections_[k].second.size();
+    header.bytes += entries[k].size * sizeof(double);
+  }
+  std::vector<std::byte> bytes(header.bytes);
+  std::memcpy(bytes.data(), &header, sizeof(header));
+  std::memcpy(
+      bytes.data() + sizeof(header), entries.data(),
+      entries.size() * sizeof(entry_t));
+  for (size_t k = 0; k < sections_.size(); k++)
+    std::memcpy(
+        bytes.data() + entries[k].offset, sections_[k].second.data(),
+        entries[k].size * sizeof(double));
+  return bytes;
+}
+
+//! Writes all sections added to `filename`, aborting on failure.
+void snapshot::writer::write(const std::string& filename) const {
+  std::vector<std::byte> bytes = this->serialise();
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+  if (!file)
+    error(__func__, __FILE__, __LINE__, " cannot write " + filename, 1);
+}
+
+}  // end namespace gyronimo.
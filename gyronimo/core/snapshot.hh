@@ -0,0 +1,133 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @snapshot.hh, this file is part of ::gyronimo::
+
+#ifndef GYRONIMO_SNAPSHOT
+#define GYRONIMO_SNAPSHOT
+
+#include <gyronimo/core/mapped_file.hh>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gyronimo {
+
+//! Named arrays of doubles, memory-mapped from a binary file.
+/*!
+    Stores the state of fully built objects (e.g., the spline coefficients of
+    `morphism_vmec` or `equilibrium_vmec`) so that other runs may restore them
+    without recomputation. Files are written by a `snapshot::writer` and
+    consist of a header (magic string, format `version`, number of sections,
+    total size), a table of contents (name, offset, and size of each section),
+    and the sections themselves, all 8-byte aligned in native byte order. The
+    constructor maps the file and checks its structure, the sections being read
+    in place via `operator[]` (i.e., no copies are made and the pages are shared
+    by all processes on the same node). Objects restored from a snapshot may
+    point into its mapping, which must thus outlive them.
+
+    Alternatively, the snapshot may live in the POSIX shared-memory object
+    `shared_name` (e.g., "/w7x_snapshot"), with no file involved. The first
+    process to get there creates the object, calls `build` to get the
+    sections, and copies them into it before raising a ready flag, all other
+    processes (concurrent or later) waiting for the flag and mapping the object
+    read-only. Thus, the sections are built once per node and shared by all
+    processes, rather than duplicated by each of them. The object starts with a
+    control block holding its own format version (checked on attachment) and
+    the process id of its creator, and survives the processes using it, until
+    removed by `remove_shared()` (or a reboot). The creator holds an exclusive
+    `flock` on the object until the flag is raised, removing the object if
+    `build` throws or the process exits (e.g., by `error()`) before that.
+    Waiting processes finding the lock released with no flag raised (i.e., the
+    creator was killed) take over and build the sections themselves. Waiting
+    for longer than `timeout` seconds aborts, as does attaching to an object
+    of an incompatible version (which has to be removed first). Consistency
+    with the equilibrium at hand is checked by the objects restored from the
+    snapshot.
+*/
+class snapshot {
+ public:
+  static constexpr uint64_t version = 1;
+  class writer;
+  snapshot(const std::string& filename);
+  snapshot(
+      const std::string& shared_name, const std::function<writer()>& build,
+      double timeout = 60);
+  ~snapshot() {};
+
+  bool contains(const std::string& name) const;
+  std::span<const double> operator[](const std::string& name) const;
+  static void remove_shared(const std::string& shared_name);
+
+  //! Collects named arrays and writes them in the `snapshot` format.
+  class writer {
+   public:
+    writer() {};
+    ~writer() {};
+    void add(const std::string& name, std::span<const double> data);
+    void add(const std::string& name, double value);
+    std::vector<std::byte> serialise() const;
+    void write(const std::string& filename) const;
+   private:
+    std::vector<std::pair<std::string, std::vector<double>>> sections_;
+  };
+ private:
+  struct header_t {
+    char magic[8];
+    uint64_t version, sections, bytes;
+  };
+  struct entry_t {
+    char name[48];
+    uint64_t offset, size;  // in bytes from the start and in doubles.
+  };
+  struct control_t {
+    char magic[8];
+    uint64_t version, ready, owner, padding[4];  // keeps 64-byte alignment.
+  };
+  static constexpr char magic_[8] = {'g', 'y', 'r', 'o', 's', 'n', 'a', 'p'};
+  static constexpr char shared_magic_[8] = {
+      'g', 'y', 'r', 'o', 's', 'h', 'm', '1'};
+  const mapped_file file_;
+  std::map<std::string, std::span<const double>> sections_;
+
+  void index(const std::byte* data, size_t size, const std::string& name);
+  static std::string attach(
+      const std::string& shared_name, const std::function<writer()>& build,
+      double timeout);
+  static bool take_over(
+      const std::string& shared_name, const std::function<writer()>& build);
+  static void fill(
+      int descriptor, const std::string& shared_name,
+      const std::function<writer()>& build);
+  struct pending_t {
+    std::mutex mutex;
+    std::vector<std::string> names;
+  };
+  static pending_t& pending();
+  static void set_pending(const std::string& shared_name, bool is_pending);
+  static void remove_pending();
+};
+
+}  // end namespace gyronimo.
+
+#endif  // GYRONIMO_SNAPSHOT
@@ -0,0 +1,128 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @tokeniser.hh, this file is part of ::gyronimo::
+
+#ifndef GYRONIMO_TOKENISER
+#define GYRONIMO_TOKENISER
+
+#include <gyronimo/core/error.hh>
+
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace gyronimo {
+
+//! Sequential reader of whitespace-separated numbers in a text buffer.
+/*!
+    A light replacement for `std::istream::operator>>` on large numeric text
+    files (typically mapped with `mapped_file`). Tokens are converted with
+    `std::from_chars`, which rounds correctly like the `strtod` family behind
+    the stream operators, such that the values read are identical. As with the
+    latter, a single leading `+` is allowed, overflows abort, and underflows
+    return the `strtod` result (zero or subnormal). Unlike the latter, a token
+    not entirely made of a number aborts, instead of silently splitting it
+    (e.g., Fortran `1.0D+00`), whereas `inf` and `nan` are accepted. Tokens may
+    also be skipped without any conversion. The buffer must outlive the
+    `tokeniser`.
+*/
+class tokeniser {
+ public:
+  tokeniser(std::string_view text) : text_(text), position_(0) {};
+  ~tokeniser() {};
+
+  template<typename T> T next();
+  template<typename Range> void read(Range&& range);
+  void skip(size_t tokens);
+  bool at_end();
+ private:
+  std::string_view text_;
+  size_t position_;
+  std::string_view next_token();
+  template<typename T>
+  static bool underflow(std::string_view token, T& value);
+  static bool is_space(char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' ||
+        c == '\v' || c == '\f';
+  };
+};
+
+//! Converts the next token to `T`, aborting on failure.
+template<typename T>
+T tokeniser::next() {
+  std::string_view token = this->next_token();
+  if (token.size() > 1 && token[0] == '+' && token[1] != '-')
+    token.remove_prefix(1);
+  T value {};
+  auto [end, status] =
+      std::from_chars(token.data(), token.data() + token.size(), value);
+  if constexpr (std::is_floating_point_v<T>)
+    if (status == std::errc::result_out_of_range &&
+        end == token.data() + token.size() && underflow(token, value))
+      status = std::errc();
+  if (status != std::errc() || end != token.data() + token.size())
+    error(__func__, __FILE__, __LINE__,
+          " invalid token '" + std::string(token) + "'.", 1);
+  return value;
+}
+
+//! Converts `token` with `strtod` and co., telling whether it did not overflow.
+template<typename T>
+bool tokeniser::underflow(std::string_view token, T& value) {
+  std::string text(token);
+  if constexpr (std::is_same_v<T, float>)
+    value = std::strtof(text.c_str(), nullptr);
+  else if constexpr (std::is_same_v<T, double>)
+    value = std::strtod(text.c_str(), nullptr);
+  else
+    value = std::strtold(text.c_str(), nullptr);
+  return std::isfinite(value);
+}
+
+//! Fills every element of `range` with the next tokens, in order.
+template<typename Range>
+void tokeniser::read(Range&& range) {
+  for (auto& value : range)
+    value = this->next<std::remove_cvref_t<decltype(value)>>();
+}
+
+//! Advances past the next `tokens` tokens, without converting them.
+inline void tokeniser::skip(size_t tokens) {
+  for (size_t k = 0; k < tokens; k++) this->next_token();
+}
+
+//! Tells whether only whitespace is left.
+inline bool tokeniser::at_end() {
+  while (position_ < text_.size() && is_space(text_[position_])) position_++;
+  return position_ == text_.size();
+}
+
+inline std::string_view tokeniser::next_token() {
+  if (this->at_end())
+    error(__func__, __FILE__, __LINE__, " unexpected end of text.", 1);
+  size_t start = position_;
+  while (position_ < text_.size() && !is_space(text_[position_])) position_++;
+  return text_.substr(start, position_ - start);
+}
+
+}  // end namespace gyronimo.
+
+#endif  // GYRONIMO_TOKENISER
@@ -0,0 +1,183 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @ensemble.hh, this file is part of ::gyronimo::
+
+#ifndef GYRONIMO_ENSEMBLE
+#define GYRONIMO_ENSEMBLE
+
+#include <gyronimo/core/error.hh>
+#include <gyronimo/dynamics/odeint_adapter.hh>
+
+#include <boost/numeric/odeint/stepper/runge_kutta4.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace gyronimo {
+
+//! Integrates an ensemble of orbits of a dynamical system `F` in parallel.
+/*!
+    All orbits share the same (read-only) dynamical system `F`, which must
+    provide the type `F::state` and `F::state operator()(state, time)`, as
+    `guiding_centre` or `lorentz` do. Each orbit is advanced by a fourth-order
+    Runge-Kutta algorithm with fixed step `dt` until `tfinal` is reached, until
+    the optional `stop_condition` returns `true` (e.g., a particle leaving the
+    equilibrium domain), or until any state component becomes non-finite. The
+    corresponding `ensemble::outcome` is stored alongside the last state and
+    time of each orbit.
+
+    Orbits are distributed over `threads()` workers, each one owning a queue of
+    pending orbit indices. Since orbit costs vary by orders of magnitude (e.g.,
+    promptly lost versus trapped particles), idle workers steal pending orbits
+    from the front of the other queues while their owners consume the back.
+    Results are written at the orbit's own index, so the output ordering is
+    deterministic and independent of the number of threads. All objects reached
+    by `F::operator()` (fields, metrics, morphisms, interpolators) must be safe
+    for concurrent read-only use.
+*/
+template<class F>
+class ensemble {
+ public:
+  using state = typename F::state;
+  using stop_condition = std::function<bool(const state&, double)>;
+  enum outcome { completed = 0, stopped = 1, diverged = 2 };
+  struct orbit {
+    state final_state;
+    double final_time;
+    size_t steps;
+    outcome status;
+  };
+
+  ensemble(const F* dynamical_system, size_t threads = 0);
+  ~ensemble() {};
+
+  std::vector<orbit> operator()(
+      const std::vector<state>& initial_states, double tfinal, double dt,
+      const stop_condition& stop = stop_condition()) const;
+
+  size_t threads() const { return threads_; };
+  const F* dynamical_system() const { return dynamical_system_; };
+ private:
+  const F* dynamical_system_;
+  const size_t threads_;
+
+  class work_queue {
+   public:
+    void push(size_t i) { items_.push_back(i); };
+    std::optional<size_t> pop();
+    std::optional<size_t> steal();
+   private:
+    std::mutex mutex_;
+    std::deque<size_t> items_;
+  };
+
+  orbit integrate(
+      const state& initial, double tfinal, double dt,
+      const stop_condition& stop) const;
+};
+
+//! Sets the shared dynamical system and the number of worker threads.
+/*!
+    If `threads` is zero, the number of concurrent threads supported by the
+    hardware is used instead.
+*/
+template<class F>
+ensemble<F>::ensemble(const F* dynamical_system, size_t threads)
+    : dynamical_system_(dynamical_system),
+      threads_(
+          threads ? threads
+                  : std::max(1u, std::thread::hardware_concurrency())) {
+  if (!dynamical_system_)
+    error(__func__, __FILE__, __LINE__, "null dynamical system.", 1);
+}
+
+//! Integrates all `initial_states`, returning one `orbit` per initial state.
+template<class F>
+std::vector<typename ensemble<F>::orbit> ensemble<F>::operator()(
+    const std::vector<state>& initial_states, double tfinal, double dt,
+    const stop_condition& stop) const {
+  if (!(dt > 0)) error(__func__, __FILE__, __LINE__, "invalid time step.", 1);
+  size_t orbits = initial_states.size();
+  std::vector<orbit> results(orbits);
+  size_t workers = std::min(threads_, std::max(orbits, size_t(1)));
+  std::vector<work_queue> queues(workers);
+  for (size_t i = 0; i < orbits; i++) queues[i * workers / orbits].push(i);
+  auto worker = [&](size_t id) {
+    for (;;) {
+      std::optional<size_t> next = queues[id].pop();
+      for (size_t k = 1; !next && k < workers; k++)
+        next = queues[(id + k) % workers].steal();
+      if (!next) return;  // no orbits are ever added, all queues are empty.
+      results[*next] = this->integrate(initial_states[*next], tfinal, dt, stop);
+    }
+  };
+  std::vector<std::jthread> pool;
+  pool.reserve(workers - 1);
+  for (size_t id = 1; id < workers; id++) pool.emplace_back(worker, id);
+  worker(0);
+  return results;  // std::jthread joins all workers on destruction.
+}
+
+//! Integrates a single orbit up to `tfinal` or its earlier termination.
+template<class F>
+typename ensemble<F>::orbit ensemble<F>::integrate(
+    const state& initial, double tfinal, double dt,
+    const stop_condition& stop) const {
+  boost::numeric::odeint::runge_kutta4<state> stepper;
+  odeint_adapter<F> system(dynamical_system_);
+  state s = initial;
+  size_t nsteps = (size_t)std::ceil(tfinal / dt - 1.0e-9);
+  for (size_t n = 0; n < nsteps; n++) {
+    double t = n * dt;
+    stepper.do_step(system, s, t, dt);
+    if (!std::ranges::all_of(s, [](double x) { return std::isfinite(x); }))
+      return {s, t + dt, n + 1, diverged};
+    if (stop && stop(s, t + dt)) return {s, t + dt, n + 1, stopped};
+  }
+  return {s, nsteps * dt, nsteps, completed};
+}
+
+//! Pops the most recently pushed orbit index (owner side).
+template<class F>
+std::optional<size_t> ensemble<F>::work_queue::pop() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (items_.empty()) return std::nullopt;
+  size_t i = items_.back();
+  items_.pop_back();
+  return i;
+}
+
+//! Steals the least recently pushed orbit index (thief side).
+template<class F>
+std::optional<size_t> ensemble<F>::work_queue::steal() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (items_.empty()) return std::nullopt;
+  size_t i = items_.front();
+  items_.pop_front();
+  return i;
+}
+
+}  // end namespace gyronimo.
+
+#endif  // GYRONIMO_ENSEMBLE
@@ -71,33 +71,52 @@ guiding_centre::guiding_centre(
 */
 guiding_centre::state guiding_centre::operator()(
     const state& s, const double& time) const {
+  double B_time = this->magnetic_time(time);
+  return this->evaluate(
+      s, B_time, magnetic_field_->bundle(this->get_position(s), B_time));
+}
+
+//! Evaluates the time derivative of `s` given the magnetic-field bundle `B`.
+guiding_centre::state guiding_centre::evaluate(
+    const state& s, double B_time, const IR3field_c1::field_bundle& B) const {
   IR3 q = this->get_position(s);
   double vpp = this->get_vpp(s);
-  double jacobian = magnetic_field_->metric()->jacobian(q);
-  double B_time = time * iB_time_factor_;
-  IR3 covariant_b = magnetic_field_->covariant_versor(q, B_time);
-  IR3 contravariant_b = magnetic_field_->contravariant_versor(q, B_time);
+  double inverseB = 1.0 / B.magnitude;
+  IR3 covariant_b = inverseB * B.covariant;
+  IR3 contravariant_b = inverseB * B.contravariant;
   auto [iO_tilde, iota, c_tilde, d_tilde] = this->dynamical_system_coefficients(
-      q, vpp, B_time, jacobian, covariant_b);
+      q, vpp, B_time, B, covariant_b);
   IR3 dot_X = iota *
       (vpp * contravariant_b +
        iO_tilde *
            (vpp * c_tilde +
-            cross_product<contravariant>(covariant_b, d_tilde, jacobian)));
+            cross_product<contravariant>(covariant_b, d_tilde, B.jacobian)));
   double dot_vpp =
       -iota * inner_product(contravariant_b + iO_tilde * c_tilde, d_tilde);
   return {dot_X[IR3::u], dot_X[IR3::v], dot_X[IR3::w], dot_vpp};
 }
 
+//! Evaluates the time derivatives `dsdt` of all states in the batch `s`.
+void guiding_centre::operator()(
+    const batch& s, batch& dsdt, const double& time) const {
+  const IR3field_c1* B = magnetic_field_;
+  this->evaluate_batch(
+      s, dsdt, time,
+      [B](const IR3span& q, double t,
+          std::span<IR3field_c1::field_bundle> out) {
+        B->bundle_batch(q, t, out);
+      });
+}
+
 //! Returns the sequence @f$\{1/\tilde{\Omega},\iota,\tilde{c},\tilde{d}\}@f$.
 std::tuple<double, double, IR3, IR3>
 guiding_centre::dynamical_system_coefficients(
-    IR3& q, double vpp, double B_time, double jacobian,
-    IR3& covariant_b) const {
-  double inverseB = 1 / magnetic_field_->magnitude(q, B_time);
-  IR3 gradB = Lref_ * magnetic_field_->del_magnitude(q, B_time);
+    const IR3& q, double vpp, double B_time,
+    const IR3field_c1::field_bundle& B, const IR3& covariant_b) const {
+  double inverseB = 1 / B.magnitude;
+  IR3 gradB = Lref_ * B.del_magnitude;
   auto [curl_b, partial_t_b] =
-      this->del_versor_b(q, B_time, inverseB, jacobian, gradB, covariant_b);
+      this->del_versor_b(B, inverseB, gradB, covariant_b);
   IR3 c_tilde = vpp * curl_b;
   IR3 d_tilde = 0.5 * mu_tilde_ * gradB + vpp * partial_t_b;
   if (electric_field_) {
@@ -117,16 +136,14 @@ guiding_centre::dynamical_system_coefficients(
     = \mathbf{B}/B@f$ is the versor of a vector @f$\mathbf{B}@f$.
 */
 std::array<IR3, 2> guiding_centre::del_versor_b(
-    IR3& q, double B_time, double inverseB, double jacobian, IR3& gradB,
-    IR3& covariant_b) const {
-  double partial_t_B =
-      iB_time_factor_ * magnetic_field_->partial_t_magnitude(q, B_time);
+    const IR3field_c1::field_bundle& B, double inverseB, const IR3& gradB,
+    const IR3& covariant_b) const {
+  double partial_t_B = iB_time_factor_ * B.partial_t_magnitude;
   IR3 curl_b = inverseB *
-      (Lref_ * magnetic_field_->curl(q, B_time) -
-       cross_product<contravariant>(gradB, covariant_b, jacobian));
+      (Lref_ * B.curl -
+       cross_product<contravariant>(gradB, covariant_b, B.jacobian));
   IR3 partial_t_b = inverseB *
-      (iB_time_factor_ * magnetic_field_->partial_t_covariant(q, B_time) -
-       partial_t_B * covariant_b);
+      (iB_time_factor_ * B.partial_t_covariant - partial_t_B * covariant_b);
   return {curl_b, partial_t_b};
 }
 
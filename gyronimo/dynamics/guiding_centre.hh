@@ -20,9 +20,13 @@
 #ifndef GYRONIMO_GUIDING_CENTRE
 #define GYRONIMO_GUIDING_CENTRE
 
+#include <gyronimo/core/per_thread.hh>
+#include <gyronimo/dynamics/state_batch.hh>
 #include <gyronimo/fields/IR3field_c1.hh>
 
+#include <algorithm>
 #include <array>
+#include <vector>
 
 namespace gyronimo {
 
@@ -70,16 +74,29 @@ namespace gyronimo {
     pointed to by the electromagnetic fields. This approach takes advantage of
     all tensor and differential calculus machinery already implemented in
     `metric_covariant`, `IR3field`, and `IR3field_c1`, which can eventually be
-    specialised and optimised in further derived classes. The type
+    specialised and optimised in further derived classes. The magnetic field
+    and all its derivatives are obtained with a single call to
+    `IR3field_c1::bundle()` per evaluation of the equations. The type
     `guiding_centre::state` implements the state of the dynamical system,
     storing the curvilinear position divided by the reference length
     (@f$\tilde{q}^\gamma = q^\gamma/L_{ref}@f$) and the normalised parallel
     velocity. Member functions are provided to convert between these types
     [i.e., `get_position(state)`, `get_vpp(state)`, `generate_state(q, v)`].
+    Ensembles of particles sharing the same time can be stored in the type
+    `guiding_centre::batch`, holding the arrays @f$\{\tilde{q}^u\}@f$,
+    @f$\{\tilde{q}^v\}@f$, @f$\{\tilde{q}^w\}@f$, and
+    @f$\{\tilde{v}_\parallel\}@f$ contiguously (SoA layout), which can be
+    advanced by `lockstep_rk4`. Their right-hand side is evaluated in chunks of
+    `chunk_size` particles, each chunk taking the magnetic field from a single
+    call to `IR3field_c1::bundle_batch()` (by default, one call to each of the
+    field's batched member functions and to the metric's `jacobian_batch`).
+    The magnetic field is called through its virtual interface,
+    `guiding_centre_t` binding its concrete type at compile time.
 */
 class guiding_centre {
  public:
   using state = std::array<double, 4>;
+  using batch = state_batch<4>;
   enum vpp_sign { minus = -1, plus = 1 };
 
   guiding_centre(
@@ -87,6 +104,7 @@ class guiding_centre {
       const IR3field* E);
   ~guiding_centre() {};
   state operator()(const state& s, const double& time) const;
+  void operator()(const batch& s, batch& dsdt, const double& time) const;
 
   double Lref() const { return Lref_; };
   double Tref() const { return Tref_; };
@@ -103,6 +121,16 @@ class guiding_centre {
       const double& time) const;
   const IR3field* electric_field() const { return electric_field_; };
   const IR3field_c1* magnetic_field() const { return magnetic_field_; };
+ protected:
+  static constexpr size_t chunk_size = 64;
+
+  double magnetic_time(double time) const { return time * iB_time_factor_; };
+  state evaluate(
+      const state& s, double B_time,
+      const IR3field_c1::field_bundle& B) const;
+  template<typename Fill>
+  void evaluate_batch(
+      const batch& s, batch& dsdt, double time, const Fill& fill) const;
  private:
   const double Lref_, Vref_, qom_tilde_, mu_tilde_;
   const IR3field_c1* magnetic_field_;
@@ -110,13 +138,14 @@ class guiding_centre {
   const double Tref_;
   const double iB_time_factor_, iE_time_factor_;
   const double Oref_tilde_, iOref_tilde_;
+  per_thread<std::vector<IR3field_c1::field_bundle>> bundles_;
 
   std::tuple<double, double, IR3, IR3> dynamical_system_coefficients(
-      IR3& q, double vpp, double B_time, double jacobian,
-      IR3& covariant_b) const;
+      const IR3& q, double vpp, double B_time,
+      const IR3field_c1::field_bundle& B, const IR3& covariant_b) const;
   std::array<IR3, 2> del_versor_b(
-      IR3& q, double B_time, double inverseB, double jacobian, IR3& gradB,
-      IR3& covariant_b) const;
+      const IR3field_c1::field_bundle& B, double inverseB, const IR3& gradB,
+      const IR3& covariant_b) const;
 };
 
 //! Returns the parallel energy, normalised to `Uref`.
@@ -129,6 +158,41 @@ inline IR3 guiding_centre::get_position(const state& s) const {
   return {Lref_ * s[0], Lref_ * s[1], Lref_ * s[2]};
 }
 
+//! Evaluates `dsdt` for the batch `s`, the field being supplied by `fill`.
+/*!
+    The batch is processed in chunks of up to `chunk_size` particles, whose
+    curvilinear positions are gathered into an `IR3span`. The call `fill(q,
+    B_time, B)` must then store the magnetic-field bundles of all positions
+    `q` (at the field's time `B_time`) into the span `B`. The bundles are
+    stored in a per-instance and per-thread buffer (see `per_thread`),
+    allocated by the first call in each thread and reused afterwards.
+*/
+template<typename Fill>
+void guiding_centre::evaluate_batch(
+    const batch& s, batch& dsdt, double time, const Fill& fill) const {
+  if (dsdt.size() != s.size()) dsdt.resize(s.size());
+  double B_time = this->magnetic_time(time);
+  std::array<double, chunk_size> u, v, w;
+  std::vector<IR3field_c1::field_bundle>& B = bundles_.local();
+  if (B.size() < chunk_size) {
+    IR3 zero = {0, 0, 0};
+    B.resize(chunk_size, {zero, zero, 0, zero, zero, zero, zero, 0, 0});
+  }
+  for (size_t first = 0; first < s.size(); first += chunk_size) {
+    size_t n = std::min(chunk_size, s.size() - first);
+    for (size_t i = 0; i < n; i++) {
+      u[i] = Lref_ * s[0][first + i];
+      v[i] = Lref_ * s[1][first + i];
+      w[i] = Lref_ * s[2][first + i];
+    }
+    fill(
+        IR3span({u.data(), n}, {v.data(), n}, {w.data(), n}), B_time,
+        std::span(B.data(), n));
+    for (size_t i = 0; i < n; i++)
+      dsdt.set(first + i, this->evaluate(s.get(first + i), B_time, B[i]));
+  }
+}
+
 }  // end namespace gyronimo.
 
 #endif  // GYRONIMO_GUIDING_CENTRE.
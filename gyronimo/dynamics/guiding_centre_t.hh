@@ -0,0 +1,82 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @guiding_centre_t.hh, this file is part of ::gyronimo::
+
+#ifndef GYRONIMO_GUIDING_CENTRE_T
+#define GYRONIMO_GUIDING_CENTRE_T
+
+#include <gyronimo/dynamics/guiding_centre.hh>
+
+#include <concepts>
+
+namespace gyronimo {
+
+//! Guiding-centre equations of motion bound to a concrete magnetic field type.
+/*!
+    Same dynamical system as `guiding_centre`, from which it derives, but the
+    magnetic field is held as a pointer to its concrete type `Field` and its
+    `bundle()` (or `bundle_batch()`, for batches) is called with a qualified
+    (i.e., non-virtual) call, which the compiler may inline. Apart from the
+    dispatch, the arithmetic is shared with the parent class and the results
+    are identical. Fields whose `bundle()` is itself free of virtual calls
+    (e.g., `equilibrium_circular`) thus get the whole right-hand side
+    statically dispatched, except for the optional electric field. Objects of
+    this type can replace `guiding_centre` ones in `lockstep_rk4`, `ensemble`,
+    and `odeint` steppers.
+*/
+template<typename Field> requires std::derived_from<Field, IR3field_c1>
+class guiding_centre_t : public guiding_centre {
+ public:
+  guiding_centre_t(
+      double Lref, double Vref, double qom, double mu, const Field* B,
+      const IR3field* E)
+      : guiding_centre(Lref, Vref, qom, mu, B, E), field_(B) {};
+  ~guiding_centre_t() {};
+  state operator()(const state& s, const double& time) const;
+  void operator()(const batch& s, batch& dsdt, const double& time) const;
+
+  const Field* magnetic_field() const { return field_; };
+ private:
+  const Field* field_;
+};
+
+//! Evaluates the time derivative `dsdt` of the dynamical state `s` at `time`.
+template<typename Field> requires std::derived_from<Field, IR3field_c1>
+inline guiding_centre::state guiding_centre_t<Field>::operator()(
+    const state& s, const double& time) const {
+  double B_time = this->magnetic_time(time);
+  return this->evaluate(
+      s, B_time, field_->Field::bundle(this->get_position(s), B_time));
+}
+
+//! Evaluates the time derivatives `dsdt` of all states in the batch `s`.
+template<typename Field> requires std::derived_from<Field, IR3field_c1>
+void guiding_centre_t<Field>::operator()(
+    const batch& s, batch& dsdt, const double& time) const {
+  const Field* B = field_;
+  this->evaluate_batch(
+      s, dsdt, time,
+      [B](const IR3span& q, double t,
+          std::span<IR3field_c1::field_bundle> out) {
+        B->Field::bundle_batch(q, t, out);
+      });
+}
+
+}  // end namespace gyronimo.
+
+#endif  // GYRONIMO_GUIDING_CENTRE_T
@@ -0,0 +1,83 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @lockstep_rk4.hh, this file is part of ::gyronimo::
+
+#ifndef GYRONIMO_LOCKSTEP_RK4
+#define GYRONIMO_LOCKSTEP_RK4
+
+#include <cstddef>
+
+namespace gyronimo {
+
+//! Classical fourth-order Runge-Kutta advancing a batch of states in lockstep.
+/*!
+    The dynamical system `F` must define the type `F::batch` (a `state_batch`
+    or any type with the same `size`, `resize`, `flat_size`, and `data`
+    members) and the batched right-hand side `void operator()(const F::batch&
+    s, F::batch& dsdt, double time) const`, as `guiding_centre` does. All
+    particles share the same time and time step, each one of the four stages
+    being evaluated for the whole batch in a single call. The arithmetic is the
+    same as in `boost::numeric::odeint::runge_kutta4`, particle by particle.
+    Internal stage buffers are resized on the first step and reused afterwards,
+    one stepper object should be used per thread.
+*/
+template<class F>
+class lockstep_rk4 {
+ public:
+  using batch = typename F::batch;
+  lockstep_rk4() {};
+  ~lockstep_rk4() {};
+  void do_step(const F& system, batch& s, double time, double dt);
+ private:
+  batch k1_, k2_, k3_, k4_, x_;
+};
+
+//! Advances all states in `s` from `time` to `time + dt`.
+template<class F>
+void lockstep_rk4<F>::do_step(
+    const F& system, batch& s, double time, double dt) {
+  if (x_.size() != s.size()) {
+    k1_.resize(s.size());
+    k2_.resize(s.size());
+    k3_.resize(s.size());
+    k4_.resize(s.size());
+    x_.resize(s.size());
+  }
+  const size_t n = s.flat_size();
+  const double dt2 = dt * (1.0 / 2);
+  const double dt3 = dt * (1.0 / 3), dt6 = dt * (1.0 / 6);
+  double* y = s.data();
+  double* x = x_.data();
+  system(s, k1_, time);
+  const double* k1 = k1_.data();
+  for (size_t i = 0; i < n; i++) x[i] = y[i] + dt2 * k1[i];
+  system(x_, k2_, time + dt2);
+  const double* k2 = k2_.data();
+  for (size_t i = 0; i < n; i++) x[i] = y[i] + dt2 * k2[i];
+  system(x_, k3_, time + dt2);
+  const double* k3 = k3_.data();
+  for (size_t i = 0; i < n; i++) x[i] = y[i] + dt * k3[i];
+  system(x_, k4_, time + dt);
+  const double* k4 = k4_.data();
+  for (size_t i = 0; i < n; i++)
+    y[i] = y[i] + dt6 * k1[i] + dt3 * k2[i] + dt3 * k3[i] + dt6 * k4[i];
+}
+
+}  // end namespace gyronimo.
+
+#endif  // GYRONIMO_LOCKSTEP_RK4
@@ -65,14 +65,24 @@ lorentz::lorentz(
     @f}
     where @f$-\tilde{\Gamma}^k_{ij} \tilde{v}^i \tilde{v}^j@f$ are the
     inertial-force terms with @f$\tilde{\Gamma}^k_{ij} = L_{ref}
-    \Gamma^k_{ij}@f$.
+    \Gamma^k_{ij}@f$. All metric quantities are obtained with a single call to
+    `metric_covariant::bundle()`.
 */
 lorentz::state lorentz::operator()(const state& s, const double& time) const {
+  IR3 q = this->get_position(s);
+  return this->evaluate(
+      s, time, magnetic_field_->contravariant(q, this->magnetic_time(time)),
+      metric_->bundle(q, true));
+}
+
+//! Evaluates the time derivative of `s` given the field `B` and metric `g`.
+lorentz::state lorentz::evaluate(
+    const state& s, const double& time, const IR3& B,
+    const metric_covariant::metric_bundle& g) const {
   IR3 q = this->get_position(s), v = this->get_velocity(s);
-  IR3 B = magnetic_field_->contravariant(q, iB_time_factor_ * time);
-  IR3 v_cross_B = cross_product<covariant>(v, B, metric_->jacobian(q));
-  IR3 dot_v = Lref_ * metric_->inertial_force(q, v) +
-      Oref_tilde_ * metric_->to_contravariant(v_cross_B, q);
+  IR3 v_cross_B = cross_product<covariant>(v, B, g.jacobian);
+  IR3 dot_v = Lref_ * g.inertial_force(v) +
+      Oref_tilde_ * g.to_contravariant(v_cross_B);
   if (electric_field_)
     dot_v +=
         Eref_tilde_ * electric_field_->contravariant(q, iE_time_factor_ * time);
@@ -60,6 +60,8 @@ namespace gyronimo {
     components of the normalised velocity (@f$\tilde{v}^\gamma@f$). Member
     functions are provided to convert between these types [i.e.,
     `get_position(state)`, `get_velocity(state)`, `generate_state(q, v)`].
+    Fields and metric are called through their virtual interfaces, `lorentz_t`
+    binding their concrete types at compile time.
 */
 class lorentz {
  public:
@@ -85,6 +87,11 @@ class lorentz {
   state generate_state(const IR3& q, const IR3& v) const;
   const IR3field* electric_field() const { return electric_field_; };
   const IR3field* magnetic_field() const { return magnetic_field_; };
+ protected:
+  double magnetic_time(double time) const { return time * iB_time_factor_; };
+  state evaluate(
+      const state& s, const double& time, const IR3& B,
+      const metric_covariant::metric_bundle& g) const;
  private:
   const double Lref_, Vref_, qom_tilde_;
   const IR3field *magnetic_field_, *electric_field_;
@@ -0,0 +1,84 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @lorentz_t.hh, this file is part of ::gyronimo::
+
+#ifndef GYRONIMO_LORENTZ_T
+#define GYRONIMO_LORENTZ_T
+
+#include <gyronimo/core/error.hh>
+#include <gyronimo/dynamics/lorentz.hh>
+
+#include <concepts>
+
+namespace gyronimo {
+
+//! Lorentz-force equations bound to concrete field and metric types.
+/*!
+    Same dynamical system as `lorentz`, from which it derives, but the magnetic
+    field and its metric are held as pointers to their concrete types `Field`
+    and `Metric`, with `Field::contravariant()` and `Metric::bundle()` being
+    called with qualified (i.e., non-virtual) calls, which the compiler may
+    inline. Apart from the dispatch, the arithmetic is shared with the parent
+    class and the results are identical. The metric of the magnetic field must
+    be of type `Metric` (or derived from it), otherwise the constructor aborts.
+*/
+template<typename Field, typename Metric>
+  requires std::derived_from<Field, IR3field> &&
+      std::derived_from<Metric, metric_covariant>
+class lorentz_t : public lorentz {
+ public:
+  lorentz_t(
+      const double& Lref, const double& Vref, const double& qom,
+      const Field* B, const IR3field* E);
+  ~lorentz_t() {};
+  state operator()(const state& s, const double& time) const;
+
+  const Field* magnetic_field() const { return field_; };
+  const Metric* metric() const { return metric_; };
+ private:
+  const Field* field_;
+  const Metric* metric_;
+};
+
+template<typename Field, typename Metric>
+  requires std::derived_from<Field, IR3field> &&
+      std::derived_from<Metric, metric_covariant>
+lorentz_t<Field, Metric>::lorentz_t(
+    const double& Lref, const double& Vref, const double& qom,
+    const Field* B, const IR3field* E)
+    : lorentz(Lref, Vref, qom, B, E), field_(B),
+      metric_(dynamic_cast<const Metric*>(B->metric())) {
+  if (!metric_)
+    error(__func__, __FILE__, __LINE__, " mismatched metric type.", 1);
+}
+
+//! Evaluates the time derivative `dsdt` of the dynamical state `s` at `time`.
+template<typename Field, typename Metric>
+  requires std::derived_from<Field, IR3field> &&
+      std::derived_from<Metric, metric_covariant>
+inline lorentz::state lorentz_t<Field, Metric>::operator()(
+    const state& s, const double& time) const {
+  IR3 q = this->get_position(s);
+  return this->evaluate(
+      s, time, field_->Field::contravariant(q, this->magnetic_time(time)),
+      metric_->Metric::bundle(q, true));
+}
+
+}  // end namespace gyronimo.
+
+#endif  // GYRONIMO_LORENTZ_T
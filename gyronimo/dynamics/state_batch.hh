@@ -0,0 +1,98 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @state_batch.hh, this file is part of ::gyronimo::
+
+#ifndef GYRONIMO_STATE_BATCH
+#define GYRONIMO_STATE_BATCH
+
+#include <array>
+#include <span>
+#include <vector>
+
+namespace gyronimo {
+
+//! Batch of `size()` dynamical states with `D` components, in SoA layout.
+/*!
+    Component `k` of all states is stored contiguously in the span returned by
+    `operator[](k)`, all components sharing a single buffer (accessible through
+    `data()` and `flat_size()`) with the layout `{x0[0..n), x1[0..n), ...}`.
+    This layout lets right-hand sides loop over particles with unit stride and
+    lets steppers (e.g., `lockstep_rk4`) update the whole batch as a single
+    array. Single states are converted from/to `std::array<double, D>` by `get`
+    and `set`.
+*/
+template<size_t D>
+class state_batch {
+ public:
+  using state = std::array<double, D>;
+
+  state_batch(size_t n = 0) : size_(n), data_(D * n, 0.0) {};
+  state_batch(const std::vector<state>& states);
+  ~state_batch() {};
+
+  size_t size() const { return size_; };
+  size_t flat_size() const { return data_.size(); };
+  static constexpr size_t components() { return D; };
+  void resize(size_t n);
+
+  double* data() { return data_.data(); };
+  const double* data() const { return data_.data(); };
+  std::span<double> operator[](size_t k) {
+    return {data_.data() + k * size_, size_};
+  };
+  std::span<const double> operator[](size_t k) const {
+    return {data_.data() + k * size_, size_};
+  };
+
+  state get(size_t i) const;
+  void set(size_t i, const state& s);
+ private:
+  size_t size_;
+  std::vector<double> data_;
+};
+
+template<size_t D>
+state_batch<D>::state_batch(const std::vector<state>& states)
+    : state_batch(states.size()) {
+  for (size_t i = 0; i < size_; i++) this->set(i, states[i]);
+}
+
+//! Resizes the batch, all values are reset to zero.
+template<size_t D>
+void state_batch<D>::resize(size_t n) {
+  size_ = n;
+  data_.assign(D * n, 0.0);
+}
+
+//! Gathers the components of the `i`-th state.
+template<size_t D>
+typename state_batch<D>::state state_batch<D>::get(size_t i) const {
+  state s;
+  for (size_t k = 0; k < D; k++) s[k] = data_[k * size_ + i];
+  return s;
+}
+
+//! Scatters the components of `s` into the `i`-th state.
+template<size_t D>
+void state_batch<D>::set(size_t i, const state& s) {
+  for (size_t k = 0; k < D; k++) data_[k * size_ + i] = s[k];
+}
+
+}  // end namespace gyronimo.
+
+#endif  // GYRONIMO_STATE_BATCH
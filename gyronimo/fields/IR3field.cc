@@ -53,4 +53,35 @@ IR3 IR3field::contravariant_versor(const IR3& position, double time) const {
   return {imagnitude*A[IR3::u], imagnitude*A[IR3::v], imagnitude*A[IR3::w]};
 }
 
+void IR3field::contravariant_batch(
+    const IR3span& positions, double time, std::span<IR3> out) const {
+  check_batch_size(positions, out);
+  for (size_t i = 0; i < positions.size(); i++)
+    out[i] = this->contravariant(positions[i], time);
+}
+void IR3field::covariant_batch(
+    const IR3span& positions, double time, std::span<IR3> out) const {
+  check_batch_size(positions, out);
+  for (size_t i = 0; i < positions.size(); i++)
+    out[i] = this->covariant(positions[i], time);
+}
+void IR3field::magnitude_batch(
+    const IR3span& positions, double time, std::span<double> out) const {
+  check_batch_size(positions, out);
+  for (size_t i = 0; i < positions.size(); i++)
+    out[i] = this->magnitude(positions[i], time);
+}
+void IR3field::covariant_versor_batch(
+    const IR3span& positions, double time, std::span<IR3> out) const {
+  check_batch_size(positions, out);
+  for (size_t i = 0; i < positions.size(); i++)
+    out[i] = this->covariant_versor(positions[i], time);
+}
+void IR3field::contravariant_versor_batch(
+    const IR3span& positions, double time, std::span<IR3> out) const {
+  check_batch_size(positions, out);
+  for (size_t i = 0; i < positions.size(); i++)
+    out[i] = this->contravariant_versor(positions[i], time);
+}
+
 } // end namespace gyronimo.
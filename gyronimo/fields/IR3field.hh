@@ -21,6 +21,7 @@
 #define GYRONIMO_IR3FIELD
 
 #include <gyronimo/core/IR3algebra.hh>
+#include <gyronimo/core/IR3span.hh>
 #include <gyronimo/metrics/metric_covariant.hh>
 
 namespace gyronimo {
@@ -43,6 +44,13 @@ namespace gyronimo {
     `covariant_versor(...)`, and `contravariant_versor(...)`] is provided in
     general terms, but is left virtual to allow optimized implementations in
     derived classes.
+
+    Each member function has a batched counterpart (e.g., `magnitude_batch`)
+    evaluating a whole `IR3span` of positions at the same time into a
+    caller-owned buffer, without any memory allocation. The default
+    implementations just loop over the single-position functions; derived
+    classes may override them to share setup work between positions and to
+    avoid one virtual call per position.
 */
 class IR3field {
  public:
@@ -59,6 +67,17 @@ class IR3field {
   virtual IR3 covariant_versor(const IR3& position, double time) const;
   virtual IR3 contravariant_versor(const IR3& position, double time) const;
 
+  virtual void contravariant_batch(
+      const IR3span& positions, double time, std::span<IR3> out) const;
+  virtual void covariant_batch(
+      const IR3span& positions, double time, std::span<IR3> out) const;
+  virtual void magnitude_batch(
+      const IR3span& positions, double time, std::span<double> out) const;
+  virtual void covariant_versor_batch(
+      const IR3span& positions, double time, std::span<IR3> out) const;
+  virtual void contravariant_versor_batch(
+      const IR3span& positions, double time, std::span<IR3> out) const;
+
   double m_factor() const {return m_factor_;};
   double t_factor() const {return t_factor_;};
   const metric_covariant* metric() const {return covariant_metric_;};
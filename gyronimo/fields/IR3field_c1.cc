@@ -20,6 +20,8 @@
 #include <gyronimo/fields/IR3field_c1.hh>
 #include <gyronimo/core/contraction.hh>
 
+#include <cmath>
+
 namespace gyronimo {
 
 //! Partial derivatives of the covariant components.
@@ -96,4 +98,135 @@ double IR3field_c1::partial_t_magnitude(
           this->covariant(position, time)));
 }
 
+//! Field and derivatives at `position` and `time`, one call per member.
+IR3field_c1::field_bundle IR3field_c1::bundle(
+    const IR3& position, double time) const {
+  return {
+      this->contravariant(position, time), this->covariant(position, time),
+      this->magnitude(position, time), this->del_magnitude(position, time),
+      this->curl(position, time),
+      this->partial_t_contravariant(position, time),
+      this->partial_t_covariant(position, time),
+      this->partial_t_magnitude(position, time),
+      this->metric()->jacobian(position)};
+}
+
+//! Builds a `field_bundle` from the contravariant field and the metric.
+/*!
+    Applies the same rules as `covariant()`, `magnitude()`, `del_covariant()`,
+    `curl()`, `del_magnitude()`, `partial_t_covariant()`, and
+    `partial_t_magnitude()`, given the field `B`, its derivatives `dB` and
+    `dtB`, the metric `g`, its derivatives `dg`, and its `jacobian`, all at the
+    same position and time. Each quantity is thus evaluated only once.
+*/
+IR3field_c1::field_bundle IR3field_c1::bundle_from(
+    const IR3& B, const dIR3& dB, const IR3& dtB,
+    const SM3& g, const dSM3& dg, double jacobian) {
+  IR3 B_covariant = contraction(g, B);
+  double magnitude = std::sqrt(inner_product(B, B_covariant));
+  dIR3 c1 = contraction<second>(dg, B);
+  dIR3 c2 = contraction<first>(dB, g);
+  dIR3 dB_covariant = {
+      c1[dIR3::uu] + c2[dIR3::uu], c1[dIR3::uv] + c2[dIR3::uv],
+      c1[dIR3::uw] + c2[dIR3::uw], c1[dIR3::vu] + c2[dIR3::vu],
+      c1[dIR3::vv] + c2[dIR3::vv], c1[dIR3::vw] + c2[dIR3::vw],
+      c1[dIR3::wu] + c2[dIR3::wu], c1[dIR3::wv] + c2[dIR3::wv],
+      c1[dIR3::ww] + c2[dIR3::ww]};
+  double ijacobian = 1.0 / jacobian;
+  IR3 curl = {
+      (dB_covariant[dIR3::wv] - dB_covariant[dIR3::vw])*ijacobian,
+      (dB_covariant[dIR3::uw] - dB_covariant[dIR3::wu])*ijacobian,
+      (dB_covariant[dIR3::vu] - dB_covariant[dIR3::uv])*ijacobian};
+  IR3 del_magnitude = (0.5/magnitude)*(
+      contraction<first>(dB_covariant, B) +
+      contraction<first>(dB, B_covariant));
+  IR3 dtB_covariant = contraction(g, dtB);
+  double partial_t_magnitude = (0.5/magnitude)*(
+      inner_product(dtB_covariant, B) + inner_product(dtB, B_covariant));
+  return {
+      B, B_covariant, magnitude, del_magnitude, curl,
+      dtB, dtB_covariant, partial_t_magnitude, jacobian};
+}
+
+//! Bundles at all `positions`, one batched call per member function and chunk.
+void IR3field_c1::bundle_batch(
+    const IR3span& positions, double time,
+    std::span<field_bundle> out) const {
+  check_batch_size(positions, out);
+  scratch_t& x = scratch_.local();
+  if (x.B.size() < chunk_size) {
+    IR3 zero = {0, 0, 0};
+    for (std::vector<IR3>* v :
+         {&x.B, &x.B_covariant, &x.del_magnitude, &x.curl, &x.dtB,
+          &x.dtB_covariant})
+      v->resize(chunk_size, zero);
+    for (std::vector<double>* v :
+         {&x.magnitude, &x.partial_t_magnitude, &x.jacobian})
+      v->resize(chunk_size);
+  }
+  for (size_t first = 0; first < positions.size(); first += chunk_size) {
+    IR3span chunk = positions.subspan(first, chunk_size);
+    size_t n = chunk.size();
+    auto head = [n](auto& v) { return std::span(v.data(), n); };
+    this->contravariant_batch(chunk, time, head(x.B));
+    this->covariant_batch(chunk, time, head(x.B_covariant));
+    this->magnitude_batch(chunk, time, head(x.magnitude));
+    this->del_magnitude_batch(chunk, time, head(x.del_magnitude));
+    this->curl_batch(chunk, time, head(x.curl));
+    this->partial_t_contravariant_batch(chunk, time, head(x.dtB));
+    this->partial_t_covariant_batch(chunk, time, head(x.dtB_covariant));
+    this->partial_t_magnitude_batch(
+        chunk, time, head(x.partial_t_magnitude));
+    this->metric()->jacobian_batch(chunk, head(x.jacobian));
+    for (size_t p = 0; p < n; p++)
+      out[first + p] = {
+          x.B[p], x.B_covariant[p], x.magnitude[p], x.del_magnitude[p],
+          x.curl[p], x.dtB[p], x.dtB_covariant[p], x.partial_t_magnitude[p],
+          x.jacobian[p]};
+  }
+}
+
+void IR3field_c1::del_contravariant_batch(
+    const IR3span& positions, double time, std::span<dIR3> out) const {
+  check_batch_size(positions, out);
+  for (size_t i = 0; i < positions.size(); i++)
+    out[i] = this->del_contravariant(positions[i], time);
+}
+void IR3field_c1::partial_t_contravariant_batch(
+    const IR3span& positions, double time, std::span<IR3> out) const {
+  check_batch_size(positions, out);
+  for (size_t i = 0; i < positions.size(); i++)
+    out[i] = this->partial_t_contravariant(positions[i], time);
+}
+void IR3field_c1::del_magnitude_batch(
+    const IR3span& positions, double time, std::span<IR3> out) const {
+  check_batch_size(positions, out);
+  for (size_t i = 0; i < positions.size(); i++)
+    out[i] = this->del_magnitude(positions[i], time);
+}
+void IR3field_c1::partial_t_magnitude_batch(
+    const IR3span& positions, double time, std::span<double> out) const {
+  check_batch_size(positions, out);
+  for (size_t i = 0; i < positions.size(); i++)
+    out[i] = this->partial_t_magnitude(positions[i], time);
+}
+void IR3field_c1::del_covariant_batch(
+    const IR3span& positions, double time, std::span<dIR3> out) const {
+  check_batch_size(positions, out);
+  for (size_t i = 0; i < positions.size(); i++)
+    out[i] = this->del_covariant(positions[i], time);
+}
+void IR3field_c1::partial_t_covariant_batch(
+    const IR3span& positions, double time, std::span<IR3> out) const {
+  check_batch_size(positions, out);
+  for (size_t i = 0; i < positions.size(); i++)
+    out[i] = this->partial_t_covariant(positions[i], time);
+}
+void IR3field_c1::curl_batch(
+    const IR3span& positions, double time, std::span<IR3> out) const {
+  check_batch_size(positions, out);
+  for (size_t i = 0; i < positions.size(); i++)
+    out[i] = this->curl(positions[i], time);
+}
+
 } // end namespace gyronimo.
@@ -20,8 +20,11 @@
 #ifndef GYRONIMO_IR3FIELD_C1
 #define GYRONIMO_IR3FIELD_C1
 
+#include <gyronimo/core/per_thread.hh>
 #include <gyronimo/fields/IR3field.hh>
 
+#include <vector>
+
 namespace gyronimo {
 
 //! Time-dependent, continuously differentiable field in @f$\mathbb{R}^3@f$.
@@ -39,10 +42,33 @@ namespace gyronimo {
     respect to the normalised time, whilst spacial derivatives are taken with
     respect to the arbitrary coordinates defined by the covariant_metric object.
     Conversion to SI values is achieved using the normalization constants
-    `m_factor` and `t_factor`.
+    `m_factor` and `t_factor`. As in `IR3field`, batched counterparts of all
+    derivatives (e.g., `del_magnitude_batch`) loop over the single-position
+    functions by default.
+
+    Clients needing the field and several of its derivatives at the same
+    position and time (e.g., `guiding_centre`) should call `bundle()`, which
+    returns all of them at once in a `field_bundle`. The default version just
+    calls each member function in turn; derived classes may override it to
+    share the underlying evaluations (see `bundle_from()`). Likewise,
+    `bundle_batch()` fills the bundles of a whole `IR3span` of positions with a
+    call to each batched member function (and to the metric's
+    `jacobian_batch`) per chunk of `chunk_size` positions, the intermediate
+    arrays being kept per instance and per thread (see `per_thread`). Derived
+    classes with a cheaper `bundle()` may override it.
 */
 class IR3field_c1 : public IR3field {
  public:
+  //! Field, derivatives, and metric jacobian at a given position and time.
+  struct field_bundle {
+    IR3 contravariant, covariant;
+    double magnitude;
+    IR3 del_magnitude, curl;
+    IR3 partial_t_contravariant, partial_t_covariant;
+    double partial_t_magnitude;
+    double jacobian;
+  };
+
   IR3field_c1(double m_factor, double t_factor, const metric_covariant* g)
       : IR3field(m_factor, t_factor, g) {};
   virtual ~IR3field_c1() override {};
@@ -57,6 +83,36 @@ class IR3field_c1 : public IR3field {
   virtual dIR3 del_covariant( const IR3& position, double time) const;
   virtual IR3 partial_t_covariant(const IR3& position, double time) const;
   virtual IR3 curl(const IR3& position, double time) const;
+  virtual field_bundle bundle(const IR3& position, double time) const;
+  virtual void bundle_batch(
+      const IR3span& positions, double time,
+      std::span<field_bundle> out) const;
+
+  virtual void del_contravariant_batch(
+      const IR3span& positions, double time, std::span<dIR3> out) const;
+  virtual void partial_t_contravariant_batch(
+      const IR3span& positions, double time, std::span<IR3> out) const;
+  virtual void del_magnitude_batch(
+      const IR3span& positions, double time, std::span<IR3> out) const;
+  virtual void partial_t_magnitude_batch(
+      const IR3span& positions, double time, std::span<double> out) const;
+  virtual void del_covariant_batch(
+      const IR3span& positions, double time, std::span<dIR3> out) const;
+  virtual void partial_t_covariant_batch(
+      const IR3span& positions, double time, std::span<IR3> out) const;
+  virtual void curl_batch(
+      const IR3span& positions, double time, std::span<IR3> out) const;
+ protected:
+  static constexpr size_t chunk_size = 64;
+  static field_bundle bundle_from(
+      const IR3& B, const dIR3& dB, const IR3& dtB,
+      const SM3& g, const dSM3& dg, double jacobian);
+ private:
+  struct scratch_t {
+    std::vector<IR3> B, B_covariant, del_magnitude, curl, dtB, dtB_covariant;
+    std::vector<double> magnitude, partial_t_magnitude, jacobian;
+  };
+  per_thread<scratch_t> scratch_;
 };
 
 } // end namespace gyronimo.
@@ -20,19 +20,29 @@
 #ifndef GYRONIMO_IR3FIELD_C1_CACHE
 #define GYRONIMO_IR3FIELD_C1_CACHE
 
+#include <gyronimo/core/multislot_cache.hh>
+#include <gyronimo/core/per_thread.hh>
 #include <gyronimo/fields/IR3field_c1.hh>
 
 namespace gyronimo {
 
 //! Calltrace layer over objects derived from `IR3field_c1`.
 /*!
-    Defines a depth-1 cache layer (or a decorator) for all member functions
+    Defines a depth-`N` cache layer (or a decorator) for all member functions
     declared in the `IR3field_c1` interface. Because it derives from its
     template argument, it can be used to replace pointers or references to
     objects of that type in client code. The cache object is constructed with
     the same constructor call as its template argument.
+
+    Each instance keeps its own cache in each thread (see `per_thread`), so
+    concurrent readers are safe and distinct instances of the same type never
+    evict each other's entries. Every member function remembers its `N` most
+    recent evaluations (see `multislot_cache`), the default being enough for
+    the four stages of a Runge-Kutta step, with the observer's sample point
+    hitting the first stage of the next step.
 */
-template<typename T> requires std::derived_from<T, IR3field_c1>
+template<typename T, size_t N = 4>
+  requires std::derived_from<T, IR3field_c1>
 class IR3field_c1_cache : public T {
  public:
   template<typename... Args> IR3field_c1_cache(Args... args) : T(args...) {};
@@ -49,120 +59,108 @@ class IR3field_c1_cache : public T {
   virtual dIR3 del_covariant(const IR3& q, double t) const override;
   virtual IR3 partial_t_covariant(const IR3& q, double t) const override;
   virtual IR3 curl(const IR3& q, double t) const override;
+  virtual IR3field_c1::field_bundle bundle(
+      const IR3& q, double t) const override;
  private:
-  static inline IR3 un_init_ = {123456789., 987654321., 192837465.};
+  struct slots_t {
+    multislot_cache<N, IR3, IR3, double> contravariant;
+    multislot_cache<N, IR3, IR3, double> covariant;
+    multislot_cache<N, double, IR3, double> magnitude;
+    multislot_cache<N, IR3, IR3, double> covariant_versor;
+    multislot_cache<N, IR3, IR3, double> contravariant_versor;
+    multislot_cache<N, dIR3, IR3, double> del_contravariant;
+    multislot_cache<N, IR3, IR3, double> partial_t_contravariant;
+    multislot_cache<N, IR3, IR3, double> del_magnitude;
+    multislot_cache<N, double, IR3, double> partial_t_magnitude;
+    multislot_cache<N, dIR3, IR3, double> del_covariant;
+    multislot_cache<N, IR3, IR3, double> partial_t_covariant;
+    multislot_cache<N, IR3, IR3, double> curl;
+    multislot_cache<N, IR3field_c1::field_bundle, IR3, double> bundle;
+  };
+  per_thread<slots_t> slots_;
 };
 
-template<typename T> requires std::derived_from<T, IR3field_c1>
-IR3 IR3field_c1_cache<T>::contravariant(const IR3& q, double t) const {
-  thread_local double cache_t = -1;
-  thread_local IR3 cache_q = un_init_, cache_eval = {0, 0, 0};
-  if (q == cache_q && t == cache_t) return cache_eval;
-  cache_q = q;
-  cache_t = t;
-  return cache_eval = T::contravariant(q, t);
+template<typename T, size_t N> requires std::derived_from<T, IR3field_c1>
+IR3 IR3field_c1_cache<T, N>::contravariant(const IR3& q, double t) const {
+  auto& cache = slots_.local().contravariant;
+  if (auto hit = cache.find(q, t)) return *hit;
+  return cache.insert(T::contravariant(q, t), q, t);
 }
-template<typename T> requires std::derived_from<T, IR3field_c1>
-IR3 IR3field_c1_cache<T>::covariant(const IR3& q, double t) const {
-  thread_local double cache_t = -1;
-  thread_local IR3 cache_q = un_init_, cache_eval = {0, 0, 0};
-  if (q == cache_q && t == cache_t) return cache_eval;
-  cache_q = q;
-  cache_t = t;
-  return cache_eval = T::covariant(q, t);
+template<typename T, size_t N> requires std::derived_from<T, IR3field_c1>
+IR3 IR3field_c1_cache<T, N>::covariant(const IR3& q, double t) const {
+  auto& cache = slots_.local().covariant;
+  if (auto hit = cache.find(q, t)) return *hit;
+  return cache.insert(T::covariant(q, t), q, t);
 }
-template<typename T> requires std::derived_from<T, IR3field_c1>
-double IR3field_c1_cache<T>::magnitude(const IR3& q, double t) const {
-  thread_local double cache_t = -1, cache_eval = 0;
-  thread_local IR3 cache_q = un_init_;
-  if (q == cache_q && t == cache_t) return cache_eval;
-  cache_q = q;
-  cache_t = t;
-  return cache_eval = T::magnitude(q, t);
+template<typename T, size_t N> requires std::derived_from<T, IR3field_c1>
+double IR3field_c1_cache<T, N>::magnitude(const IR3& q, double t) const {
+  auto& cache = slots_.local().magnitude;
+  if (auto hit = cache.find(q, t)) return *hit;
+  return cache.insert(T::magnitude(q, t), q, t);
 }
-template<typename T> requires std::derived_from<T, IR3field_c1>
-IR3 IR3field_c1_cache<T>::covariant_versor(const IR3& q, double t) const {
-  thread_local double cache_t = -1;
-  thread_local IR3 cache_q = un_init_, cache_eval = {0, 0, 0};
-  if (q == cache_q && t == cache_t) return cache_eval;
-  cache_q = q;
-  cache_t = t;
-  return cache_eval = T::covariant_versor(q, t);
+template<typename T, size_t N> requires std::derived_from<T, IR3field_c1>
+IR3 IR3field_c1_cache<T, N>::covariant_versor(const IR3& q, double t) const {
+  auto& cache = slots_.local().covariant_versor;
+  if (auto hit = cache.find(q, t)) return *hit;
+  return cache.insert(T::covariant_versor(q, t), q, t);
 }
-template<typename T> requires std::derived_from<T, IR3field_c1>
-IR3 IR3field_c1_cache<T>::contravariant_versor(const IR3& q, double t) const {
-  thread_local double cache_t = -1;
-  thread_local IR3 cache_q = un_init_, cache_eval = {0, 0, 0};
-  if (q == cache_q && t == cache_t) return cache_eval;
-  cache_q = q;
-  cache_t = t;
-  return cache_eval = T::contravariant_versor(q, t);
+template<typename T, size_t N> requires std::derived_from<T, IR3field_c1>
+IR3 IR3field_c1_cache<T, N>::contravariant_versor(
+    const IR3& q, double t) const {
+  auto& cache = slots_.local().contravariant_versor;
+  if (auto hit = cache.find(q, t)) return *hit;
+  return cache.insert(T::contravariant_versor(q, t), q, t);
 }
-template<typename T> requires std::derived_from<T, IR3field_c1>
-dIR3 IR3field_c1_cache<T>::del_contravariant(const IR3& q, double t) const {
-  thread_local double cache_t = -1;
-  thread_local IR3 cache_q = un_init_;
-  thread_local dIR3 cache_eval = {0, 0, 0, 0, 0, 0, 0, 0, 0};
-  if (q == cache_q && t == cache_t) return cache_eval;
-  cache_q = q;
-  cache_t = t;
-  return cache_eval = T::del_contravariant(q, t);
+template<typename T, size_t N> requires std::derived_from<T, IR3field_c1>
+dIR3 IR3field_c1_cache<T, N>::del_contravariant(const IR3& q, double t) const {
+  auto& cache = slots_.local().del_contravariant;
+  if (auto hit = cache.find(q, t)) return *hit;
+  return cache.insert(T::del_contravariant(q, t), q, t);
 }
-template<typename T> requires std::derived_from<T, IR3field_c1>
-IR3 IR3field_c1_cache<T>::partial_t_contravariant(
+template<typename T, size_t N> requires std::derived_from<T, IR3field_c1>
+IR3 IR3field_c1_cache<T, N>::partial_t_contravariant(
     const IR3& q, double t) const {
-  thread_local double cache_t = -1;
-  thread_local IR3 cache_q = un_init_, cache_eval = {0, 0, 0};
-  if (q == cache_q && t == cache_t) return cache_eval;
-  cache_q = q;
-  cache_t = t;
-  return cache_eval = T::partial_t_contravariant(q, t);
+  auto& cache = slots_.local().partial_t_contravariant;
+  if (auto hit = cache.find(q, t)) return *hit;
+  return cache.insert(T::partial_t_contravariant(q, t), q, t);
 }
-template<typename T> requires std::derived_from<T, IR3field_c1>
-IR3 IR3field_c1_cache<T>::del_magnitude(const IR3& q, double t) const {
-  thread_local double cache_t = -1;
-  thread_local IR3 cache_q = un_init_, cache_eval = {0, 0, 0};
-  if (q == cache_q && t == cache_t) return cache_eval;
-  cache_q = q;
-  cache_t = t;
-  return cache_eval = T::del_magnitude(q, t);
+template<typename T, size_t N> requires std::derived_from<T, IR3field_c1>
+IR3 IR3field_c1_cache<T, N>::del_magnitude(const IR3& q, double t) const {
+  auto& cache = slots_.local().del_magnitude;
+  if (auto hit = cache.find(q, t)) return *hit;
+  return cache.insert(T::del_magnitude(q, t), q, t);
 }
-template<typename T> requires std::derived_from<T, IR3field_c1>
-double IR3field_c1_cache<T>::partial_t_magnitude(const IR3& q, double t) const {
-  thread_local double cache_t = -1, cache_eval = 0;
-  thread_local IR3 cache_q = un_init_;
-  if (q == cache_q && t == cache_t) return cache_eval;
-  cache_q = q;
-  cache_t = t;
-  return cache_eval = T::partial_t_magnitude(q, t);
+template<typename T, size_t N> requires std::derived_from<T, IR3field_c1>
+double IR3field_c1_cache<T, N>::partial_t_magnitude(
+    const IR3& q, double t) const {
+  auto& cache = slots_.local().partial_t_magnitude;
+  if (auto hit = cache.find(q, t)) return *hit;
+  return cache.insert(T::partial_t_magnitude(q, t), q, t);
 }
-template<typename T> requires std::derived_from<T, IR3field_c1>
-dIR3 IR3field_c1_cache<T>::del_covariant(const IR3& q, double t) const {
-  thread_local double cache_t = -1;
-  thread_local IR3 cache_q = un_init_;
-  thread_local dIR3 cache_eval = {0, 0, 0, 0, 0, 0, 0, 0, 0};
-  if (q == cache_q && t == cache_t) return cache_eval;
-  cache_q = q;
-  cache_t = t;
-  return cache_eval = T::del_covariant(q, t);
+template<typename T, size_t N> requires std::derived_from<T, IR3field_c1>
+dIR3 IR3field_c1_cache<T, N>::del_covariant(const IR3& q, double t) const {
+  auto& cache = slots_.local().del_covariant;
+  if (auto hit = cache.find(q, t)) return *hit;
+  return cache.insert(T::del_covariant(q, t), q, t);
 }
-template<typename T> requires std::derived_from<T, IR3field_c1>
-IR3 IR3field_c1_cache<T>::partial_t_covariant(const IR3& q, double t) const {
-  thread_local double cache_t = -1;
-  thread_local IR3 cache_q = un_init_, cache_eval = {0, 0, 0};
-  if (q == cache_q && t == cache_t) return cache_eval;
-  cache_q = q;
-  cache_t = t;
-  return cache_eval = T::partial_t_covariant(q, t);
+template<typename T, size_t N> requires std::derived_from<T, IR3field_c1>
+IR3 IR3field_c1_cache<T, N>::partial_t_covariant(const IR3& q, double t) const {
+  auto& cache = slots_.local().partial_t_covariant;
+  if (auto hit = cache.find(q, t)) return *hit;
+  return cache.insert(T::partial_t_covariant(q, t), q, t);
 }
-template<typename T> requires std::derived_from<T, IR3field_c1>
-IR3 IR3field_c1_cache<T>::curl(const IR3& q, double t) const {
-  thread_local double cache_t = -1;
-  thread_local IR3 cache_q = un_init_, cache_eval = {0, 0, 0};
-  if (q == cache_q && t == cache_t) return cache_eval;
-  cache_q = q;
-  cache_t = t;
-  return cache_eval = T::curl(q, t);
+template<typename T, size_t N> requires std::derived_from<T, IR3field_c1>
+IR3 IR3field_c1_cache<T, N>::curl(const IR3& q, double t) const {
+  auto& cache = slots_.local().curl;
+  if (auto hit = cache.find(q, t)) return *hit;
+  return cache.insert(T::curl(q, t), q, t);
+}
+template<typename T, size_t N> requires std::derived_from<T, IR3field_c1>
+IR3field_c1::field_bundle IR3field_c1_cache<T, N>::bundle(
+    const IR3& q, double t) const {
+  auto& cache = slots_.local().bundle;
+  if (auto hit = cache.find(q, t)) return *hit;
+  return cache.insert(T::bundle(q, t), q, t);
 }
 
 }  // namespace gyronimo
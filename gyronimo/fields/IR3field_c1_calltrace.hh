@@ -50,6 +50,8 @@ class IR3field_c1_calltrace : public T {
   virtual dIR3 del_covariant(const IR3& q, double t) const override;
   virtual IR3 partial_t_covariant(const IR3& q, double t) const override;
   virtual IR3 curl(const IR3& q, double t) const override;
+  virtual IR3field_c1::field_bundle bundle(
+      const IR3& q, double t) const override;
 };
 
 template<typename T> requires std::derived_from<T, IR3field_c1>
@@ -116,6 +118,12 @@ IR3 IR3field_c1_calltrace<T>::curl(const IR3& q, double t) const {
   std::cout << "IR3fiedl_c1::curl(q, t)\n";
   return T::curl(q, t);
 }
+template<typename T> requires std::derived_from<T, IR3field_c1>
+IR3field_c1::field_bundle IR3field_c1_calltrace<T>::bundle(
+    const IR3& q, double t) const {
+  std::cout << "IR3fiedl_c1::bundle(q, t)\n";
+  return T::bundle(q, t);
+}
 
 }  // namespace gyronimo
 
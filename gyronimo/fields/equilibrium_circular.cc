@@ -24,8 +24,8 @@ namespace gyronimo {
 
 IR3 equilibrium_circular::contravariant(
     const IR3& position, double time) const {
-  double m = this->magnitude(position, time);
-  IR3 A = this->contravariant_versor(position, time);
+  double m = equilibrium_circular::magnitude(position, time);
+  IR3 A = equilibrium_circular::contravariant_versor(position, time);
   return {m * A[IR3::u], m * A[IR3::v], m * A[IR3::w]};
 }
 dIR3 equilibrium_circular::del_contravariant(
@@ -44,8 +44,8 @@ dIR3 equilibrium_circular::del_contravariant(
   return {0.0, 0.0, 0.0, dB_vu, dB_vv, 0.0, dB_wu, dB_wv, 0.0};
 }
 IR3 equilibrium_circular::covariant(const IR3& position, double time) const {
-  double m = this->magnitude(position, time);
-  IR3 A = this->covariant_versor(position, time);
+  double m = equilibrium_circular::magnitude(position, time);
+  IR3 A = equilibrium_circular::covariant_versor(position, time);
   return {m*A[IR3::u], m*A[IR3::v], m*A[IR3::w]};
 }
 double equilibrium_circular::magnitude(const IR3& position, double time) const {
@@ -67,13 +67,17 @@ IR3 equilibrium_circular::contravariant_versor(
 }
 IR3 equilibrium_circular::covariant_versor(
     const IR3& position, double time) const {
-  IR3 b = this->contravariant_versor(position, time);
-  return this->metric()->to_covariant(b, position);
+  IR3 b = equilibrium_circular::contravariant_versor(position, time);
+  return metric_->metric_polar_torus::to_covariant(b, position);
 }
+//! Curl from @f$J (\nabla \times \mathbf{B})^\phi = \partial_r B_\theta@f$.
 IR3 equilibrium_circular::curl(const IR3& position, double time) const {
-  double J = this->metric()->jacobian(position);
-  dIR3 dB = this->del_covariant(position, time);
-  return {0.0, 0.0, dB[dIR3::vu]/J};
+  double r = position[IR3::u];
+  double J = metric_->metric_polar_torus::jacobian(position);
+  double a = metric_->minor_radius();
+  IR3 B = equilibrium_circular::contravariant(position, time);
+  dIR3 dB = equilibrium_circular::del_contravariant(position, time);
+  return {0.0, 0.0, a*a*r*(2*B[IR3::v] + r*dB[dIR3::vu])/J};
 }
 IR3 equilibrium_circular::del_magnitude(
     const IR3& position, double time) const {
@@ -92,4 +96,84 @@ IR3 equilibrium_circular::del_magnitude(
        q*l*eps_r*std::sin(theta)*aux, 0.0};
 }
 
+//! Field and derivatives at `position`, sharing @f$q(r)@f$ and the geometry.
+IR3field_c1::field_bundle equilibrium_circular::bundle(
+    const IR3& position, double time) const {
+  double R0 = metric_->major_radius(), a = metric_->minor_radius();
+  double eps = metric_->iaspect_ratio();
+  double r = position[IR3::u], theta = position[IR3::v];
+  double cos_theta = std::cos(theta), sin_theta = std::sin(theta);
+  double q = q_(r), qprime = qprime_(r);
+  double eps_r = eps*r, duR = eps*cos_theta;
+  double R = 1.0 + eps_r*cos_theta, RR0 = R0*R;
+  double l = std::sqrt(q*q + eps_r*eps_r), lprime = (q*qprime + eps*eps_r)/l;
+  double B = l/(q*R), aux = 1.0/(RR0*l), iqR2 = 1.0/(q*R*q*R);
+  IR3 contravariant = {0.0, B*(R*aux), B*(q*aux)};
+  double dB_vu = -(qprime*R + q*duR)/(R0*q*q*R*R);
+  double J = a*a*RR0*r;
+  return {
+      contravariant,
+      {0.0, B*(a*a*r*r*(R*aux)), B*(RR0*RR0*(q*aux))}, B,
+      {(q*R*lprime - l*(R*qprime + q*duR))*iqR2,
+       q*l*eps_r*sin_theta*iqR2, 0.0},
+      {0.0, 0.0, a*a*r*(2*contravariant[IR3::v] + r*dB_vu)/J},
+      {0, 0, 0}, {0, 0, 0}, 0, J};
+}
+
+void equilibrium_circular::contravariant_batch(
+    const IR3span& positions, double time, std::span<IR3> out) const {
+  check_batch_size(positions, out);
+  for (size_t i = 0; i < positions.size(); i++)
+    out[i] = equilibrium_circular::contravariant(positions[i], time);
+}
+void equilibrium_circular::del_contravariant_batch(
+    const IR3span& positions, double time, std::span<dIR3> out) const {
+  check_batch_size(positions, out);
+  for (size_t i = 0; i < positions.size(); i++)
+    out[i] = equilibrium_circular::del_contravariant(positions[i], time);
+}
+void equilibrium_circular::covariant_batch(
+    const IR3span& positions, double time, std::span<IR3> out) const {
+  check_batch_size(positions, out);
+  for (size_t i = 0; i < positions.size(); i++)
+    out[i] = equilibrium_circular::covariant(positions[i], time);
+}
+void equilibrium_circular::magnitude_batch(
+    const IR3span& positions, double time, std::span<double> out) const {
+  check_batch_size(positions, out);
+  for (size_t i = 0; i < positions.size(); i++)
+    out[i] = equilibrium_circular::magnitude(positions[i], time);
+}
+void equilibrium_circular::covariant_versor_batch(
+    const IR3span& positions, double time, std::span<IR3> out) const {
+  check_batch_size(positions, out);
+  for (size_t i = 0; i < positions.size(); i++)
+    out[i] = equilibrium_circular::covariant_versor(positions[i], time);
+}
+void equilibrium_circular::contravariant_versor_batch(
+    const IR3span& positions, double time, std::span<IR3> out) const {
+  check_batch_size(positions, out);
+  for (size_t i = 0; i < positions.size(); i++)
+    out[i] = equilibrium_circular::contravariant_versor(positions[i], time);
+}
+void equilibrium_circular::del_magnitude_batch(
+    const IR3span& positions, double time, std::span<IR3> out) const {
+  check_batch_size(positions, out);
+  for (size_t i = 0; i < positions.size(); i++)
+    out[i] = equilibrium_circular::del_magnitude(positions[i], time);
+}
+void equilibrium_circular::curl_batch(
+    const IR3span& positions, double time, std::span<IR3> out) const {
+  check_batch_size(positions, out);
+  for (size_t i = 0; i < positions.size(); i++)
+    out[i] = equilibrium_circular::curl(positions[i], time);
+}
+void equilibrium_circular::bundle_batch(
+    const IR3span& positions, double time,
+    std::span<field_bundle> out) const {
+  check_batch_size(positions, out);
+  for (size_t i = 0; i < positions.size(); i++)
+    out[i] = equilibrium_circular::bundle(positions[i], time);
+}
+
 } // end namespace gyronimo.
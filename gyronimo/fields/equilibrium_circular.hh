@@ -33,8 +33,12 @@ namespace gyronimo {
     established by the safety-factor (`q` and `qprime`), supplied as lambda
     objects of the type `radial_profile`. Inherited member functions
     `covariant`, `magnitude`, `covariant_versor`, `contravariant_versor`,
-    `curl`, `del_magnitude` and `partial_t_magnitude` are reimplemented for
-    efficiency purposes.
+    `curl`, `del_magnitude`, `partial_t_magnitude`, and `bundle` are
+    reimplemented for efficiency purposes, calling each other (and the
+    `metric_polar_torus` members) without virtual dispatch, while `bundle`
+    evaluates `q`, `qprime`, and the poloidal terms only once. The batched
+    counterparts of these functions loop over a whole `IR3span` of positions
+    with a single virtual call.
 */
 class equilibrium_circular : public IR3field_c1 {
  public:
@@ -65,6 +69,36 @@ class equilibrium_circular : public IR3field_c1 {
   virtual double partial_t_magnitude(
       const IR3& position, double time) const override {return 0;};
   virtual IR3 curl(const IR3& position, double time) const override;
+  virtual field_bundle bundle(
+      const IR3& position, double time) const override;
+
+  virtual void contravariant_batch(
+      const IR3span& positions, double time,
+      std::span<IR3> out) const override;
+  virtual void del_contravariant_batch(
+      const IR3span& positions, double time,
+      std::span<dIR3> out) const override;
+  virtual void covariant_batch(
+      const IR3span& positions, double time,
+      std::span<IR3> out) const override;
+  virtual void magnitude_batch(
+      const IR3span& positions, double time,
+      std::span<double> out) const override;
+  virtual void covariant_versor_batch(
+      const IR3span& positions, double time,
+      std::span<IR3> out) const override;
+  virtual void contravariant_versor_batch(
+      const IR3span& positions, double time,
+      std::span<IR3> out) const override;
+  virtual void del_magnitude_batch(
+      const IR3span& positions, double time,
+      std::span<IR3> out) const override;
+  virtual void curl_batch(
+      const IR3span& positions, double time,
+      std::span<IR3> out) const override;
+  virtual void bundle_batch(
+      const IR3span& positions, double time,
+      std::span<field_bundle> out) const override;
 
   double q(double r) const {return q_(r);};
   double qprime(double r) const {return qprime_(r);};
@@ -53,5 +53,36 @@ dIR3 equilibrium_helena::del_contravariant(
       Bchi_->partial_u(s, chi), Bchi_->partial_v(s, chi) , 0.0, 
       Bphi_->partial_u(s, chi), Bphi_->partial_v(s, chi) , 0.0};
 }
+IR3field_c1::field_bundle equilibrium_helena::bundle(
+    const IR3& position, double time) const {
+  double s = position[IR3::u];
+  double chi = this->metric_->parser()->reduce_chi(position[IR3::v]);
+  metric_covariant::metric_bundle g = metric_->bundle(position);
+  return IR3field_c1::bundle_from(
+      {0.0, (*Bchi_)(s, chi), (*Bphi_)(s, chi)},
+      {0.0, 0.0, 0.0,
+          Bchi_->partial_u(s, chi), Bchi_->partial_v(s, chi), 0.0,
+          Bphi_->partial_u(s, chi), Bphi_->partial_v(s, chi), 0.0},
+      {0.0, 0.0, 0.0}, g.g, g.del, g.jacobian);
+}
+void equilibrium_helena::contravariant_batch(
+    const IR3span& positions, double time, std::span<IR3> out) const {
+  check_batch_size(positions, out);
+  for (size_t i = 0; i < positions.size(); i++)
+    out[i] = equilibrium_helena::contravariant(positions[i], time);
+}
+void equilibrium_helena::del_contravariant_batch(
+    const IR3span& positions, double time, std::span<dIR3> out) const {
+  check_batch_size(positions, out);
+  for (size_t i = 0; i < positions.size(); i++)
+    out[i] = equilibrium_helena::del_contravariant(positions[i], time);
+}
+void equilibrium_helena::bundle_batch(
+    const IR3span& positions, double time,
+    std::span<field_bundle> out) const {
+  check_batch_size(positions, out);
+  for (size_t i = 0; i < positions.size(); i++)
+    out[i] = equilibrium_helena::bundle(positions[i], time);
+}
 
 }// end namespace gyronimo.
@@ -37,7 +37,10 @@ namespace gyronimo{
     **equilibrium** field, `t_factor` is set to one.
     
     Only the minimal interface is implemented for the moment and further
-    specialisations may enhance the object's performance.
+    specialisations may enhance the object's performance. The `bundle()` of
+    a position evaluates each interpolator and the metric only once, and the
+    batched members loop over the scalar ones, with a single virtual call per
+    batch (`bundle_batch()` thus avoids the default's call to each member).
 */
 class equilibrium_helena : public IR3field_c1{
  public:
@@ -54,6 +57,18 @@ class equilibrium_helena : public IR3field_c1{
       const IR3& position, double time) const override {return {0, 0, 0};};
   virtual double partial_t_magnitude(
       const IR3& position, double time) const override {return 0;};
+  virtual field_bundle bundle(
+      const IR3& position, double time) const override;
+
+  virtual void contravariant_batch(
+      const IR3span& positions, double time,
+      std::span<IR3> out) const override;
+  virtual void del_contravariant_batch(
+      const IR3span& positions, double time,
+      std::span<dIR3> out) const override;
+  virtual void bundle_batch(
+      const IR3span& positions, double time,
+      std::span<field_bundle> out) const override;
 
   double R0() const {return metric_->parser()->rmag();};
   double B0() const {return metric_->parser()->bmag();};
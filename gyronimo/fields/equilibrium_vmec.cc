@@ -17,37 +17,115 @@
 
 // @equilibrium_vmec.cc, this file is part of ::gyronimo::
 
-#include <gyronimo/core/dblock.hh>
+#include <gyronimo/core/error.hh>
 #include <gyronimo/fields/equilibrium_vmec.hh>
 
+#include <algorithm>
 #include <cmath>
 #include <numeric>
 
 namespace gyronimo {
 
+//! Builds the field on the metric `g`, optionally truncating small harmonics.
+/*!
+    Harmonics whose largest amplitude over the radial grid and over all the
+    interpolated series (`bsupumnc`, `bsupvmnc`, `bmnc`, `bsubsmns`,
+    `bsubumnc`, and `bsubvmnc`, all normalised to `B0()`) is below `tolerance`
+    are dropped. The sum of their amplitudes, returned by `truncation_error()`,
+    bounds the resulting error in each (normalised) field component and in the
+    magnitude at the radial grid points. The default null tolerance keeps all
+    harmonics. The radial interpolators of each group are built in parallel,
+    at construction or, if `lazy` is set, on first use of the group (e.g.,
+    the covariant components are never built if only `contravariant()` is
+    called), `ifactory` having to remain valid until then. The half-mesh
+    series `bsupvmnc`, `bsupumnc`, `bmnc`, `bsubvmnc`, and `bsubumnc` are
+    interpolated on `sgrid_half_cell`, the full-mesh `bsubsmns` on `sgrid`.
+*/
 equilibrium_vmec::equilibrium_vmec(
-    const metric_vmec* g, const interpolator1d_factory* ifactory)
+    const metric_vmec* g, const interpolator1d_factory* ifactory,
+    double tolerance, bool lazy)
     : IR3field_c1(std::abs(g->my_parser()->B0()), 1.0, g),
-      metric_(g), parser_(g->my_parser()), harmonics_(parser_->mnmax_nyq()),
-      m_(parser_->xm_nyq()), n_(parser_->xn_nyq()), index_(harmonics_),
-      btheta_mn_(parser_->mnmax_nyq()), bzeta_mn_(parser_->mnmax_nyq()) {
+      metric_(g), parser_(g->my_parser()),
+      context_(g->my_morphism()->context()),
+      truncation_(context_->retained_modes(
+          {&parser_vmec::bsupvmnc, &parser_vmec::bsupumnc, &parser_vmec::bmnc,
+           &parser_vmec::bsubsmns, &parser_vmec::bsubvmnc,
+           &parser_vmec::bsubumnc},
+          parser_->mnmax_nyq(), this->m_factor(), tolerance)),
+      harmonics_(truncation_.first.size()),
+      m_(this->retained(parser_->xm_nyq())),
+      n_(this->retained(parser_->xn_nyq())), index_(harmonics_),
+      radial_(context_->radial_splines(
+          {&parser_vmec::bsupvmnc, &parser_vmec::bsupumnc}, truncation_.first,
+          this->m_factor(), true, ifactory, lazy)),
+      radial_magnitude_(context_->radial_splines(
+          {&parser_vmec::bmnc}, truncation_.first, this->m_factor(), true,
+          ifactory, lazy)),
+      radial_covariant_(context_->radial_splines(
+          {&parser_vmec::bsubvmnc, &parser_vmec::bsubumnc}, truncation_.first,
+          this->m_factor(), true, ifactory, lazy)),
+      radial_covariant_u_(context_->radial_splines(
+          {&parser_vmec::bsubsmns}, truncation_.first, this->m_factor(), false,
+          ifactory, lazy)) {
   std::iota(index_.begin(), index_.end(), 0);
-  this->build_interpolator_array(
-      bzeta_mn_, parser_->bsupvmnc() / this->m_factor(), ifactory);
-  this->build_interpolator_array(
-      btheta_mn_, parser_->bsupumnc() / this->m_factor(), ifactory);
+}
+
+//! Restores the field saved by `save()` into `s`, with no recomputation.
+/*!
+    The spline coefficients are read in place from `s`, which must outlive
+    this object. Aborts if `s` was saved from another file or any group of
+    splines is not on its mesh.
+*/
+equilibrium_vmec::equilibrium_vmec(const metric_vmec* g, const snapshot* s)
+    : IR3field_c1(std::abs(g->my_parser()->B0()), 1.0, g),
+      metric_(g), parser_(g->my_parser()),
+      context_(g->my_morphism()->context()),
+      truncation_(context_->restore_truncation(
+          *s, "equilibrium_vmec", parser_->mnmax_nyq())),
+      harmonics_(truncation_.first.size()),
+      m_(this->retained(parser_->xm_nyq())),
+      n_(this->retained(parser_->xn_nyq())), index_(harmonics_),
+      radial_(*s, "equilibrium_vmec.radial"),
+      radial_magnitude_(*s, "equilibrium_vmec.magnitude"),
+      radial_covariant_(*s, "equilibrium_vmec.covariant"),
+      radial_covariant_u_(*s, "equilibrium_vmec.covariant_u") {
+  auto on = [](const spline1d_array& radial, const narray_type& grid) {
+    return std::ranges::equal(radial.grid(), grid);
+  };
+  const narray_type& full = parser_->sgrid();
+  const narray_type& half = parser_->sgrid_half_cell();
+  if (radial_.size() != 2 * harmonics_ || !on(radial_, half) ||
+      radial_magnitude_.size() != harmonics_ || !on(radial_magnitude_, half) ||
+      radial_covariant_.size() != 2 * harmonics_ ||
+      !on(radial_covariant_, half) ||
+      radial_covariant_u_.size() != harmonics_ ||
+      !on(radial_covariant_u_, full))
+    error(__func__, __FILE__, __LINE__, " bad snapshot of splines.", 1);
+  std::iota(index_.begin(), index_.end(), 0);
+}
+
+//! Adds the retained harmonics and spline coefficients to `w`.
+void equilibrium_vmec::save(snapshot::writer& w) const {
+  context_->save_truncation(w, "equilibrium_vmec", truncation_);
+  radial_.save(w, "equilibrium_vmec.radial");
+  radial_magnitude_.save(w, "equilibrium_vmec.magnitude");
+  radial_covariant_.save(w, "equilibrium_vmec.covariant");
+  radial_covariant_u_.save(w, "equilibrium_vmec.covariant_u");
 }
 
 IR3 equilibrium_vmec::contravariant(const IR3& position, double time) const {
   double s = position[IR3::u];
   double zeta = position[IR3::v];
   double theta = position[IR3::w];
-  const auto& cis_mn = equilibrium_vmec::cached_cis(theta, zeta);
+  context_vmec::reduced_t angles = context_->reduce(theta, zeta);
+  auto cis_mn = context_->cis_nyq(angles.theta, angles.zeta);
+  const auto& radial = radial_(s, context_->half_cell(s));
   auto out = std::transform_reduce(
       index_.begin(), index_.end(), auxiliar1_t {0, 0}, std::plus<>(),
       [&](size_t i) -> auxiliar1_t {
-        double cos_mn = std::real(cis_mn[i]);
-        return {(*bzeta_mn_[i])(s)*cos_mn, (*btheta_mn_[i])(s)*cos_mn};
+        double cos_mn = std::real(cis_mn[truncation_.first[i]]);
+        return {
+            radial.f[i] * cos_mn, radial.f[i + harmonics_] * cos_mn};
       });
   return {0, out.bzeta, out.btheta};
 }
@@ -57,18 +135,22 @@ dIR3 equilibrium_vmec::del_contravariant(
   double s = position[IR3::u];
   double zeta = position[IR3::v];
   double theta = position[IR3::w];
-  const auto& cis_mn = equilibrium_vmec::cached_cis(theta, zeta);
+  context_vmec::reduced_t angles = context_->reduce(theta, zeta);
+  auto cis_mn = context_->cis_nyq(angles.theta, angles.zeta);
+  const auto& radial = radial_(s, context_->half_cell(s));
   auto out = std::transform_reduce(
       index_.begin(), index_.end(), auxiliar2_t {0, 0, 0, 0, 0, 0},
       std::plus<>(), [&](size_t i) -> auxiliar2_t {
-        double bzeta_mn_i = (*bzeta_mn_[i])(s);
-        double btheta_mn_i = (*btheta_mn_[i])(s);
-        double cos_mn_i = std::real(cis_mn[i]), sin_mn_i = std::imag(cis_mn[i]);
+        double bzeta_mn_i = radial.f[i];
+        double btheta_mn_i = radial.f[i + harmonics_];
+        std::complex<double> cis_mn_i = cis_mn[truncation_.first[i]];
+        double cos_mn_i = std::real(cis_mn_i);
+        double sin_mn_i = angles.parity * std::imag(cis_mn_i);
         return {
-            (*bzeta_mn_[i]).derivative(s) * cos_mn_i,
+            radial.df[i] * cos_mn_i,
             n_[i] * bzeta_mn_i * sin_mn_i,
             -m_[i] * bzeta_mn_i * sin_mn_i,
-            (*btheta_mn_[i]).derivative(s) * cos_mn_i,
+            radial.df[i + harmonics_] * cos_mn_i,
             n_[i] * btheta_mn_i * sin_mn_i,
             -m_[i] * btheta_mn_i * sin_mn_i};
       });
@@ -77,35 +159,296 @@ dIR3 equilibrium_vmec::del_contravariant(
       out.dbthetadu, out.dbthetadv, out.dbthetadw};
 }
 
-void equilibrium_vmec::build_interpolator_array(
-    std::vector<std::unique_ptr<interpolator1d>>& interpolator_array,
-    const narray_type& samples_array, const interpolator1d_factory* ifactory) {
-  dblock_adapter sgrid(parser_->sgrid());
-  std::transform(
-      index_.begin(), index_.end(), interpolator_array.begin(), [&](size_t i) {
-        std::slice mask_i(i, sgrid.size(), harmonics_);
-        narray_type data = samples_array[mask_i];
-        return std::move(std::unique_ptr<interpolator1d>(
-            ifactory->interpolate_data(sgrid, dblock_adapter(data))));
+//! Magnitude, from the `bmnc` series.
+double equilibrium_vmec::magnitude(const IR3& position, double time) const {
+  double s = position[IR3::u];
+  double zeta = position[IR3::v];
+  double theta = position[IR3::w];
+  context_vmec::reduced_t angles = context_->reduce(theta, zeta);
+  auto cis_mn = context_->cis_nyq(angles.theta, angles.zeta);
+  const auto& radial = radial_magnitude_(s, context_->half_cell(s));
+  return std::transform_reduce(
+      index_.begin(), index_.end(), 0.0, std::plus<>(), [&](size_t i) {
+        return radial.f[i] * std::real(cis_mn[truncation_.first[i]]);
       });
 }
 
-//! Cached evaluation of trigonometric coefficients for internal Fourier series.
-const equilibrium_vmec::cis_container_t& equilibrium_vmec::cached_cis(
-    double theta, double zeta) const {
-  thread_local double cached_theta = -1e6, cached_zeta = -1e6;
-  thread_local cis_container_t cis_mn(harmonics_);
-  if (theta != cached_theta || zeta != cached_zeta) {
-    std::transform(
-        index_.begin(), index_.end(), cis_mn.begin(),
-        [&](size_t i) -> cis_container_t::value_type {
-          double angle_mn = m_[i] * theta - n_[i] * zeta;
-          return {std::cos(angle_mn), std::sin(angle_mn)};
-        });
-    cached_theta = theta;
-    cached_zeta = zeta;
+//! Covariant components, from the `bsubsmns`, `bsubvmnc`, `bsubumnc` series.
+IR3 equilibrium_vmec::covariant(const IR3& position, double time) const {
+  double s = position[IR3::u];
+  double zeta = position[IR3::v];
+  double theta = position[IR3::w];
+  context_vmec::reduced_t angles = context_->reduce(theta, zeta);
+  auto cis_mn = context_->cis_nyq(angles.theta, angles.zeta);
+  const auto& radial_u = radial_covariant_u_(s, context_->cell(s));
+  const auto& radial = radial_covariant_(s, context_->half_cell(s));
+  auto out = std::transform_reduce(
+      index_.begin(), index_.end(), auxiliar5_t {0, 0, 0}, std::plus<>(),
+      [&](size_t i) -> auxiliar5_t {
+        std::complex<double> cis_mn_i = cis_mn[truncation_.first[i]];
+        double cos_mn_i = std::real(cis_mn_i);
+        double sin_mn_i = angles.parity * std::imag(cis_mn_i);
+        return {
+            radial_u.f[i] * sin_mn_i, radial.f[i] * cos_mn_i,
+            radial.f[i + harmonics_] * cos_mn_i};
+      });
+  return {out.bu, out.bv, out.bw};
+}
+
+IR3 equilibrium_vmec::covariant_versor(
+    const IR3& position, double time) const {
+  return (1.0 / this->magnitude(position, time)) *
+      this->covariant(position, time);
+}
+
+//! Magnitude gradient, from the `bmnc` series.
+IR3 equilibrium_vmec::del_magnitude(const IR3& position, double time) const {
+  double s = position[IR3::u];
+  double zeta = position[IR3::v];
+  double theta = position[IR3::w];
+  context_vmec::reduced_t angles = context_->reduce(theta, zeta);
+  auto cis_mn = context_->cis_nyq(angles.theta, angles.zeta);
+  const auto& radial = radial_magnitude_(s, context_->half_cell(s));
+  auto out = std::transform_reduce(
+      index_.begin(), index_.end(), auxiliar4_t {0, 0, 0, 0}, std::plus<>(),
+      [&](size_t i) -> auxiliar4_t {
+        std::complex<double> cis_mn_i = cis_mn[truncation_.first[i]];
+        double cos_mn_i = std::real(cis_mn_i);
+        double sin_mn_i = angles.parity * std::imag(cis_mn_i);
+        return {
+            radial.f[i] * cos_mn_i, radial.df[i] * cos_mn_i,
+            n_[i] * radial.f[i] * sin_mn_i, -m_[i] * radial.f[i] * sin_mn_i};
+      });
+  return {out.dbdu, out.dbdv, out.dbdw};
+}
+
+dIR3 equilibrium_vmec::del_covariant(const IR3& position, double time) const {
+  auxiliar6_t a = this->covariant_terms(position);
+  return {
+      a.dbudu, a.dbudv, a.dbudw, a.dbvdu, a.dbvdv, a.dbvdw,
+      a.dbwdu, a.dbwdv, a.dbwdw};
+}
+
+//! Field and derivatives, with a single pass over each set of harmonics.
+/*!
+    The magnitude, covariant components, and their derivatives come from the
+    `VMEC` series directly, the metric being used only for its jacobian.
+*/
+IR3field_c1::field_bundle equilibrium_vmec::bundle(
+    const IR3& position, double time) const {
+  double s = position[IR3::u];
+  double zeta = position[IR3::v];
+  double theta = position[IR3::w];
+  context_vmec::reduced_t angles = context_->reduce(theta, zeta);
+  auto cis_mn = context_->cis_nyq(angles.theta, angles.zeta);
+  const auto& radial = radial_(s, context_->half_cell(s));
+  auto b = std::transform_reduce(
+      index_.begin(), index_.end(), auxiliar1_t {0, 0}, std::plus<>(),
+      [&](size_t i) -> auxiliar1_t {
+        double cos_mn = std::real(cis_mn[truncation_.first[i]]);
+        return {
+            radial.f[i] * cos_mn, radial.f[i + harmonics_] * cos_mn};
+      });
+  auxiliar6_t a = this->covariant_terms(position);
+  double jacobian = metric_->jacobian(position);
+  double ijacobian = 1.0 / jacobian;
+  return {
+      {0, b.bzeta, b.btheta}, {a.bu, a.bv, a.bw}, a.b,
+      {a.dbdu, a.dbdv, a.dbdw},
+      {(a.dbwdv - a.dbvdw) * ijacobian, (a.dbudw - a.dbwdu) * ijacobian,
+       (a.dbvdu - a.dbudv) * ijacobian},
+      {0, 0, 0}, {0, 0, 0}, 0, jacobian};
+}
+
+//! Magnitude, covariant components, and their derivatives, in a single pass.
+equilibrium_vmec::auxiliar6_t equilibrium_vmec::covariant_terms(
+    const IR3& position) const {
+  double s = position[IR3::u];
+  double zeta = position[IR3::v];
+  double theta = position[IR3::w];
+  context_vmec::reduced_t angles = context_->reduce(theta, zeta);
+  auto cis_mn = context_->cis_nyq(angles.theta, angles.zeta);
+  size_t half_cell = context_->half_cell(s);
+  const auto& radial_b = radial_magnitude_(s, half_cell);
+  const auto& radial = radial_covariant_(s, half_cell);
+  const auto& radial_u = radial_covariant_u_(s, context_->cell(s));
+  return std::transform_reduce(
+      index_.begin(), index_.end(),
+      auxiliar6_t {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+      std::plus<>(), [&](size_t i) -> auxiliar6_t {
+        size_t l = i + harmonics_;
+        double b_mn_i = radial_b.f[i], bu_mn_i = radial_u.f[i];
+        double bv_mn_i = radial.f[i], bw_mn_i = radial.f[l];
+        std::complex<double> cis_mn_i = cis_mn[truncation_.first[i]];
+        double cos_mn_i = std::real(cis_mn_i);
+        double sin_mn_i = angles.parity * std::imag(cis_mn_i);
+        return {
+            b_mn_i * cos_mn_i,  // b_mn_i
+            radial_b.df[i] * cos_mn_i,  // dbdu_mn_i
+            n_[i] * b_mn_i * sin_mn_i,  // dbdv_mn_i
+            -m_[i] * b_mn_i * sin_mn_i,  // dbdw_mn_i
+            bu_mn_i * sin_mn_i,  // bu_mn_i
+            bv_mn_i * cos_mn_i,  // bv_mn_i
+            bw_mn_i * cos_mn_i,  // bw_mn_i
+            radial_u.df[i] * sin_mn_i,  // dbudu_mn_i
+            -n_[i] * bu_mn_i * cos_mn_i,  // dbudv_mn_i
+            m_[i] * bu_mn_i * cos_mn_i,  // dbudw_mn_i
+            radial.df[i] * cos_mn_i,  // dbvdu_mn_i
+            n_[i] * bv_mn_i * sin_mn_i,  // dbvdv_mn_i
+            -m_[i] * bv_mn_i * sin_mn_i,  // dbvdw_mn_i
+            radial.df[l] * cos_mn_i,  // dbwdu_mn_i
+            n_[i] * bw_mn_i * sin_mn_i,  // dbwdv_mn_i
+            -m_[i] * bw_mn_i * sin_mn_i  // dbwdw_mn_i
+        };
+      });
+}
+
+void equilibrium_vmec::contravariant_batch(
+    const IR3span& positions, double time, std::span<IR3> out) const {
+  check_batch_size(positions, out);
+  for (size_t first = 0; first < positions.size();
+       first += context_vmec::chunk_size) {
+    IR3span chunk = positions.subspan(first, context_vmec::chunk_size);
+    size_t n = chunk.size();
+    auto s = chunk.u();
+    auto cis = context_->cis_batch(chunk, truncation_.first, true);
+    auto cells = radial_cells(radial_, s);
+    std::fill_n(out.begin() + first, n, IR3 {0, 0, 0});
+    for (size_t i : index_)
+      for (size_t p = 0; p < n; p++) {
+        double cos_mn = std::real(cis[i * n + p]);
+        double bzeta[3], btheta[3];
+        radial_.evaluate(i, cells[p], s[p], bzeta);
+        radial_.evaluate(i + harmonics_, cells[p], s[p], btheta);
+        out[first + p][IR3::v] += bzeta[0] * cos_mn;
+        out[first + p][IR3::w] += btheta[0] * cos_mn;
+      }
+  }
+}
+
+void equilibrium_vmec::del_contravariant_batch(
+    const IR3span& positions, double time, std::span<dIR3> out) const {
+  check_batch_size(positions, out);
+  for (size_t first = 0; first < positions.size();
+       first += context_vmec::chunk_size) {
+    IR3span chunk = positions.subspan(first, context_vmec::chunk_size);
+    size_t n = chunk.size();
+    auto s = chunk.u();
+    auto cis = context_->cis_batch(chunk, truncation_.first, true);
+    auto cells = radial_cells(radial_, s);
+    std::fill_n(
+        out.begin() + first, n, dIR3 {0, 0, 0, 0, 0, 0, 0, 0, 0});
+    for (size_t i : index_)
+      for (size_t p = 0; p < n; p++) {
+        double cos_mn = std::real(cis[i * n + p]);
+        double sin_mn = std::imag(cis[i * n + p]);
+        double bzeta[3], btheta[3];
+        radial_.evaluate(i, cells[p], s[p], bzeta);
+        radial_.evaluate(i + harmonics_, cells[p], s[p], btheta);
+        dIR3& dB = out[first + p];
+        dB[dIR3::vu] += bzeta[1] * cos_mn;
+        dB[dIR3::vv] += n_[i] * bzeta[0] * sin_mn;
+        dB[dIR3::vw] += -m_[i] * bzeta[0] * sin_mn;
+        dB[dIR3::wu] += btheta[1] * cos_mn;
+        dB[dIR3::wv] += n_[i] * btheta[0] * sin_mn;
+        dB[dIR3::ww] += -m_[i] * btheta[0] * sin_mn;
+      }
+  }
+}
+
+//! Batched magnitude, from the `bmnc` series.
+void equilibrium_vmec::magnitude_batch(
+    const IR3span& positions, double time, std::span<double> out) const {
+  check_batch_size(positions, out);
+  for (size_t first = 0; first < positions.size();
+       first += context_vmec::chunk_size) {
+    IR3span chunk = positions.subspan(first, context_vmec::chunk_size);
+    size_t n = chunk.size();
+    auto s = chunk.u();
+    auto cis = context_->cis_batch(chunk, truncation_.first, true);
+    auto cells = radial_cells(radial_magnitude_, s);
+    std::fill_n(out.begin() + first, n, 0.0);
+    for (size_t i : index_)
+      for (size_t p = 0; p < n; p++) {
+        double b[3];
+        radial_magnitude_.evaluate(i, cells[p], s[p], b);
+        out[first + p] += b[0] * std::real(cis[i * n + p]);
+      }
   }
-  return cis_mn;
+}
+
+//! Batched `bundle()`, with a single pass over the harmonics of each chunk.
+/*!
+    The curl is accumulated as the antisymmetric part of the covariant
+    derivatives and divided by the jacobian, taken from one `jacobian_batch`
+    call per chunk once the harmonics are summed (the metric reusing the
+    buffer of `cis_batch()`).
+*/
+void equilibrium_vmec::bundle_batch(
+    const IR3span& positions, double time,
+    std::span<field_bundle> out) const {
+  check_batch_size(positions, out);
+  IR3 zero = {0, 0, 0};
+  std::array<double, context_vmec::chunk_size> jacobian;
+  for (size_t first = 0; first < positions.size();
+       first += context_vmec::chunk_size) {
+    IR3span chunk = positions.subspan(first, context_vmec::chunk_size);
+    size_t n = chunk.size();
+    auto s = chunk.u();
+    auto cis = context_->cis_batch(chunk, truncation_.first, true);
+    auto cells = radial_cells(radial_, s);
+    auto cells_u = radial_cells(radial_covariant_u_, s);
+    std::fill_n(
+        out.begin() + first, n,
+        field_bundle {zero, zero, 0, zero, zero, zero, zero, 0, 0});
+    for (size_t i : index_)
+      for (size_t p = 0; p < n; p++) {
+        size_t l = i + harmonics_;
+        double cos_mn = std::real(cis[i * n + p]);
+        double sin_mn = std::imag(cis[i * n + p]);
+        double bzeta[3], btheta[3], b[3], bu[3], bv[3], bw[3];
+        radial_.evaluate(i, cells[p], s[p], bzeta);
+        radial_.evaluate(l, cells[p], s[p], btheta);
+        radial_magnitude_.evaluate(i, cells[p], s[p], b);
+        radial_covariant_.evaluate(i, cells[p], s[p], bv);
+        radial_covariant_.evaluate(l, cells[p], s[p], bw);
+        radial_covariant_u_.evaluate(i, cells_u[p], s[p], bu);
+        field_bundle& B = out[first + p];
+        B.contravariant[IR3::v] += bzeta[0] * cos_mn;
+        B.contravariant[IR3::w] += btheta[0] * cos_mn;
+        B.covariant[IR3::u] += bu[0] * sin_mn;
+        B.covariant[IR3::v] += bv[0] * cos_mn;
+        B.covariant[IR3::w] += bw[0] * cos_mn;
+        B.magnitude += b[0] * cos_mn;
+        B.del_magnitude[IR3::u] += b[1] * cos_mn;
+        B.del_magnitude[IR3::v] += n_[i] * b[0] * sin_mn;
+        B.del_magnitude[IR3::w] += -m_[i] * b[0] * sin_mn;
+        B.curl[IR3::u] += (n_[i] * bw[0] + m_[i] * bv[0]) * sin_mn;
+        B.curl[IR3::v] += (m_[i] * bu[0] - bw[1]) * cos_mn;
+        B.curl[IR3::w] += (bv[1] + n_[i] * bu[0]) * cos_mn;
+      }
+    metric_->jacobian_batch(chunk, std::span(jacobian.data(), n));
+    for (size_t p = 0; p < n; p++) {
+      field_bundle& B = out[first + p];
+      B.jacobian = jacobian[p];
+      B.curl = (1.0 / jacobian[p]) * B.curl;
+    }
+  }
+}
+
+//! Entries of the `VMEC` array `x` (e.g., `xm_nyq`) at the retained harmonics.
+equilibrium_vmec::narray_type equilibrium_vmec::retained(
+    const narray_type& x) const {
+  const std::vector<size_t>& modes = truncation_.first;
+  return x[std::valarray<size_t>(modes.data(), modes.size())];
+}
+
+//! Cells of the `radial` grid containing the flux values `s` of a chunk.
+std::array<size_t, context_vmec::chunk_size> equilibrium_vmec::radial_cells(
+    const spline1d_array& radial, std::span<const double> s) {
+  std::array<size_t, context_vmec::chunk_size> cells;
+  for (size_t p = 0; p < s.size(); p++) cells[p] = radial.cell(s[p]);
+  return cells;
 }
 
 }  // end namespace gyronimo.
@@ -22,8 +22,10 @@
 
 #include <gyronimo/fields/IR3field_c1.hh>
 #include <gyronimo/interpolators/interpolator2d.hh>
+#include <gyronimo/interpolators/spline1d_array.hh>
 #include <gyronimo/metrics/metric_vmec.hh>
 
+#include <array>
 #include <complex>
 #include <memory>
 
@@ -36,15 +38,24 @@ namespace gyronimo {
     (in [m]). The coordinates are defined by the `metric_vmec` object and the
     type of 1d interpolators is set by the specific `interpolator1d_factory`
     supplied. Contravariant components have dimensions of [m^{-1}]. Being an
-    **equilibrium** field, `t_factor` is set to one. Only the minimal interface
-    is implemented here, all other functionality is inherited from the parent
-    classes.
+    **equilibrium** field, `t_factor` is set to one. The magnitude and the
+    covariant components are splined from their own series, the metric only
+    supplying the jacobian in the curl. All series but `bsubsmns` are splined
+    on the half mesh `sgrid_half_cell`, as stored by `VMEC` (this includes the
+    contravariant `bsupumnc` and `bsupvmnc`, formerly taken on `sgrid`). Below
+    its first knot (@f$s < \Delta s/2@f$, near the axis) the cubic of the
+    first half cell is extrapolated, no regularity being imposed on axis.
+    Harmonics with negligible amplitude may be dropped (see the constructor)
+    and the built state may be saved to a `snapshot`. See `bundle()` and
+    `bundle_batch()` for the fused evaluations.
 */
 class equilibrium_vmec : public IR3field_c1 {
  public:
   using narray_type = parser_vmec::narray_type;
   equilibrium_vmec(
-      const metric_vmec* g, const interpolator1d_factory* ifactory);
+      const metric_vmec* g, const interpolator1d_factory* ifactory,
+      double tolerance = 0, bool lazy = false);
+  equilibrium_vmec(const metric_vmec* g, const snapshot* s);
   virtual ~equilibrium_vmec() override {};
 
   virtual IR3 contravariant(const IR3& position, double time) const override;
@@ -56,27 +67,51 @@ class equilibrium_vmec : public IR3field_c1 {
       const IR3& position, double time) const override {return {0, 0, 0};};
   virtual double partial_t_magnitude(
       const IR3& position, double time) const override {return 0;};
-  double magnitude_vmec(const IR3& position, double time) const;
+  virtual double magnitude(const IR3& position, double time) const override;
+  virtual IR3 covariant(const IR3& position, double time) const override;
+  virtual IR3 covariant_versor(
+      const IR3& position, double time) const override;
+  virtual IR3 del_magnitude(const IR3& position, double time) const override;
+  virtual dIR3 del_covariant(
+      const IR3& position, double time) const override;
+  virtual field_bundle bundle(
+      const IR3& position, double time) const override;
+
+  virtual void contravariant_batch(
+      const IR3span& positions, double time,
+      std::span<IR3> out) const override;
+  virtual void del_contravariant_batch(
+      const IR3span& positions, double time,
+      std::span<dIR3> out) const override;
+  virtual void magnitude_batch(
+      const IR3span& positions, double time,
+      std::span<double> out) const override;
+  virtual void bundle_batch(
+      const IR3span& positions, double time,
+      std::span<field_bundle> out) const override;
 
   double R0() const { return parser_->R0(); };
   double B0() const { return parser_->B0(); };
   const metric_vmec* metric() const { return metric_; };
   const parser_vmec* my_parser() const { return parser_; };
   const morphism_vmec* my_morphism() const { return metric_->my_morphism(); };
+  size_t harmonics() const { return harmonics_; };
+  double truncation_error() const { return truncation_.second; };
+  void save(snapshot::writer& w) const;
  private:
   const metric_vmec* metric_;
   const parser_vmec* parser_;
+  const context_vmec* context_;
+  const std::pair<std::vector<size_t>, double> truncation_;
   const size_t harmonics_;
   const narray_type m_, n_;
   std::vector<size_t> index_;
-  std::vector<std::unique_ptr<interpolator1d>> btheta_mn_, bzeta_mn_;
+  const spline1d_array radial_, radial_magnitude_;
+  const spline1d_array radial_covariant_, radial_covariant_u_;
 
-  void build_interpolator_array(
-      std::vector<std::unique_ptr<interpolator1d>>& interpolator_array,
-      const narray_type& samples_array, const interpolator1d_factory* ifactory);
-
-  typedef std::vector<std::complex<double>> cis_container_t;
-  const cis_container_t& cached_cis(double theta, double zeta) const;
+  narray_type retained(const narray_type& x) const;
+  static std::array<size_t, context_vmec::chunk_size> radial_cells(
+      const spline1d_array& radial, std::span<const double> s);
 
   struct auxiliar1_t {
     double bzeta, btheta;
@@ -84,8 +119,22 @@ class equilibrium_vmec : public IR3field_c1 {
   struct auxiliar2_t {
     double dbzetadu, dbzetadv, dbzetadw, dbthetadu, dbthetadv, dbthetadw;
   };
+  struct auxiliar4_t {
+    double b, dbdu, dbdv, dbdw;
+  };
+  struct auxiliar5_t {
+    double bu, bv, bw;
+  };
+  struct auxiliar6_t {
+    double b, dbdu, dbdv, dbdw, bu, bv, bw;
+    double dbudu, dbudv, dbudw, dbvdu, dbvdv, dbvdw, dbwdu, dbwdv, dbwdw;
+  };
+  auxiliar6_t covariant_terms(const IR3& position) const;
   friend auxiliar1_t operator+(const auxiliar1_t& x, const auxiliar1_t& y);
   friend auxiliar2_t operator+(const auxiliar2_t& x, const auxiliar2_t& y);
+  friend auxiliar4_t operator+(const auxiliar4_t& x, const auxiliar4_t& y);
+  friend auxiliar5_t operator+(const auxiliar5_t& x, const auxiliar5_t& y);
+  friend auxiliar6_t operator+(const auxiliar6_t& x, const auxiliar6_t& y);
 };
 
 inline equilibrium_vmec::auxiliar1_t operator+(
@@ -102,6 +151,28 @@ inline equilibrium_vmec::auxiliar2_t operator+(
       x.dbthetadv + y.dbthetadv, x.dbthetadw + y.dbthetadw};
 }
 
+inline equilibrium_vmec::auxiliar4_t operator+(
+    const equilibrium_vmec::auxiliar4_t& x,
+    const equilibrium_vmec::auxiliar4_t& y) {
+  return {x.b + y.b, x.dbdu + y.dbdu, x.dbdv + y.dbdv, x.dbdw + y.dbdw};
+}
+
+inline equilibrium_vmec::auxiliar5_t operator+(
+    const equilibrium_vmec::auxiliar5_t& x,
+    const equilibrium_vmec::auxiliar5_t& y) {
+  return {x.bu + y.bu, x.bv + y.bv, x.bw + y.bw};
+}
+
+inline equilibrium_vmec::auxiliar6_t operator+(
+    const equilibrium_vmec::auxiliar6_t& x,
+    const equilibrium_vmec::auxiliar6_t& y) {
+  return {x.b + y.b, x.dbdu + y.dbdu, x.dbdv + y.dbdv, x.dbdw + y.dbdw,
+      x.bu + y.bu, x.bv + y.bv, x.bw + y.bw,
+      x.dbudu + y.dbudu, x.dbudv + y.dbudv, x.dbudw + y.dbudw,
+      x.dbvdu + y.dbvdu, x.dbvdv + y.dbvdv, x.dbvdw + y.dbvdw,
+      x.dbwdu + y.dbwdu, x.dbwdv + y.dbwdv, x.dbwdw + y.dbwdw};
+}
+
 }  // end namespace gyronimo.
 
 #endif  // GYRONIMO_EQUILIBRIUM_VMEC
@@ -27,15 +27,13 @@ namespace gyronimo {
 bicubic_gsl::bicubic_gsl(
     const dblock& x_range, const dblock& y_range, const dblock& z_range,
     bool is_1st_faster, size_t periodic_size, size_t reflection_size)
-    : spline_(nullptr), xacc_(nullptr), yacc_(nullptr) {
+    : spline_(nullptr), xsize_(x_range.size()), ysize_(y_range.size()) {
   if (periodic_size && reflection_size)  // if any, there can be only one!
       error(__func__, __FILE__, __LINE__,
           "incompatible boundary-condition request.", 1);
   if (periodic_size > y_range.size()/2 || reflection_size > y_range.size()/2)
       error(__func__, __FILE__, __LINE__,
           "boundary-condition extension is too large.", 1);
-  xacc_ = gsl_interp_accel_alloc();
-  yacc_ = gsl_interp_accel_alloc();
   if (!periodic_size && !reflection_size) {  // default, care only about order:
     spline_ = gsl_spline2d_alloc(
         gsl_interp2d_bicubic, x_range.size(), y_range.size());
@@ -48,6 +46,7 @@ bicubic_gsl::bicubic_gsl(
         x_range.size(), y_range.size());
   } else { // *Expensively* copies data into extended arrays:
     size_t nrows = periodic_size + reflection_size;  // ok, only one is not 0.
+    ysize_ = y_range.size() + 2*nrows;
     const double* augmented_y =
         this->augment_y_range(y_range.data(), y_range.size(), nrows);
     const double* augmented_z = this->augment_z_range(
@@ -68,8 +67,6 @@ bicubic_gsl::bicubic_gsl(
 }
 bicubic_gsl::~bicubic_gsl() {
   if (spline_) gsl_spline2d_free(spline_);
-  if (yacc_) gsl_interp_accel_free(yacc_);
-  if (xacc_) gsl_interp_accel_free(xacc_);
 }
 double* bicubic_gsl::augment_z_range(
     const double* original, size_t nfast, size_t nslow,
@@ -116,22 +113,28 @@ double* bicubic_gsl::augment_y_range(
   return augmented;
 }
 double bicubic_gsl::operator()(double x, double y) const {
-  return gsl_spline2d_eval(spline_, x, y, xacc_, yacc_);
+  auto [xacc, yacc] = this->accelerators();
+  return gsl_spline2d_eval(spline_, x, y, xacc, yacc);
 }
 double bicubic_gsl::partial_u(double x, double y) const {
-  return  gsl_spline2d_eval_deriv_x(spline_, x, y, xacc_, yacc_);
+  auto [xacc, yacc] = this->accelerators();
+  return  gsl_spline2d_eval_deriv_x(spline_, x, y, xacc, yacc);
 }
 double bicubic_gsl::partial_v(double x, double y) const {
-  return gsl_spline2d_eval_deriv_y(spline_, x, y, xacc_, yacc_);
+  auto [xacc, yacc] = this->accelerators();
+  return gsl_spline2d_eval_deriv_y(spline_, x, y, xacc, yacc);
 }
 double bicubic_gsl::partial2_uu(double x, double y) const {
-  return  gsl_spline2d_eval_deriv_xx(spline_, x, y, xacc_, yacc_);
+  auto [xacc, yacc] = this->accelerators();
+  return  gsl_spline2d_eval_deriv_xx(spline_, x, y, xacc, yacc);
 }
 double bicubic_gsl::partial2_uv(double x, double y) const {
-  return  gsl_spline2d_eval_deriv_xy(spline_, x, y, xacc_, yacc_);
+  auto [xacc, yacc] = this->accelerators();
+  return  gsl_spline2d_eval_deriv_xy(spline_, x, y, xacc, yacc);
 }
 double bicubic_gsl::partial2_vv(double x, double y) const {
-  return  gsl_spline2d_eval_deriv_yy(spline_, x, y, xacc_, yacc_);
+  auto [xacc, yacc] = this->accelerators();
+  return  gsl_spline2d_eval_deriv_yy(spline_, x, y, xacc, yacc);
 }
 
 } // end namespace gyronimo.
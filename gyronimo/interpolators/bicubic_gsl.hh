@@ -23,6 +23,8 @@
 #include <gsl/gsl_spline2d.h>
 #include <gyronimo/interpolators/interpolator2d.hh>
 
+#include <utility>
+
 namespace gyronimo {
 
 //! Bicubic spline using the [GSL library](https://www.gnu.org/software/gsl).
@@ -34,7 +36,9 @@ namespace gyronimo {
     boundary conditions are assumed for both dimensions. However, support is
     provided for periodic and reflection boundary conditions for the **second
     variable only** by extending the domain by `periodic_size` or
-    `reflection_size` samples on each side.
+    `reflection_size` samples on each side. Evaluations are safe for
+    concurrent readers, the GSL accelerators caching the last grid cell being
+    `thread_local` objects (see `spline1d_gsl`).
  */
 class bicubic_gsl : public interpolator2d {
  public:
@@ -50,8 +54,8 @@ class bicubic_gsl : public interpolator2d {
   virtual double partial2_vv(double x, double y) const override;
  private:
   gsl_spline2d *spline_;
-  gsl_interp_accel *xacc_;
-  gsl_interp_accel *yacc_;
+  size_t xsize_, ysize_;
+  std::pair<gsl_interp_accel*, gsl_interp_accel*> accelerators() const;
   double* augment_y_range(
       const double* y_range, size_t ysize, size_t nrows) const;
   double* augment_z_range(
@@ -59,6 +63,15 @@ class bicubic_gsl : public interpolator2d {
       size_t periodic_size, size_t reflection_size) const;
 };
 
+//! Per-thread accelerators, with cached cells valid for this spline's grid.
+inline std::pair<gsl_interp_accel*, gsl_interp_accel*>
+bicubic_gsl::accelerators() const {
+  thread_local gsl_interp_accel xacc = {0, 0, 0}, yacc = {0, 0, 0};
+  if (xacc.cache + 2 > xsize_) xacc.cache = 0;
+  if (yacc.cache + 2 > ysize_) yacc.cache = 0;
+  return {&xacc, &yacc};
+}
+
 class bicubic_gsl_factory : public interpolator2d_factory {
  public:
   bicubic_gsl_factory(
@@ -24,6 +24,15 @@ namespace gyronimo {
 
 interpolator1d* bspline3_boost_factory::interpolate_data(
     const dblock& x_range, const dblock& ordinates) const {
+  return this->build(x_range, ordinates);
+}
+interpolator1d* bspline3_boost_factory::interpolate_strided(
+    const dblock& x_range, const dblock_strided& ordinates) const {
+  return this->build(x_range, ordinates);
+}
+template<typename Ordinates>
+interpolator1d* bspline3_boost_factory::build(
+    const dblock& x_range, const Ordinates& ordinates) const {
   if (x_range.size() != ordinates.size())
       error(__func__, __FILE__, __LINE__, "size mismatch", 1);
   double init_x = x_range.front();
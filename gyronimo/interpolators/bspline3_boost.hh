@@ -30,16 +30,19 @@ namespace gyronimo {
     If ommited from the constructor, `left_prime` and `right_prime` will be
     computed from the sampled data in `ordinates` using forward/backward finite
     differences (errors of the order of the grid size are implied, consider more
-    accurate options).
+    accurate options). The `ordinates` may be either a `dblock` or a
+    `dblock_strided`, which is read in place.
 */
 class bspline3_boost : public interpolator1d {
  public:
-  bspline3_boost(const dblock& ordinates, double abcissa, double step)
-    : spline_(ordinates.begin(), ordinates.end(), abcissa, step) {};
-  bspline3_boost( const dblock& ordinates, double abcissa, double step,
+  template<typename Ordinates>
+  bspline3_boost(const Ordinates& ordinates, double abcissa, double step)
+    : spline_(ordinates.begin(), ordinates.end(), abcissa, step) {}
+  template<typename Ordinates>
+  bspline3_boost( const Ordinates& ordinates, double abcissa, double step,
       double left_prime, double right_prime)
     : spline_(ordinates.begin(), ordinates.end(),
-          abcissa, step, left_prime, right_prime) {};
+          abcissa, step, left_prime, right_prime) {}
   virtual ~bspline3_boost() final {};
   double operator()(double x) const final {return spline_(x);};
   double derivative(double x) const final {return spline_.prime(x);};
@@ -63,8 +66,13 @@ class bspline3_boost_factory : public interpolator1d_factory {
   bspline3_boost_factory(const policy p) : policy_(p) {};
   virtual interpolator1d* interpolate_data(
       const dblock& abcissas, const dblock& ordinates) const final;
+  virtual interpolator1d* interpolate_strided(
+      const dblock& abcissas, const dblock_strided& ordinates) const final;
  private:
   const policy policy_;
+  template<typename Ordinates>
+  interpolator1d* build(
+      const dblock& x_range, const Ordinates& ordinates) const;
 };
 
 } // end namespace gyronimo.
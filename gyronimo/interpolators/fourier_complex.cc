@@ -100,10 +100,10 @@ void fourier_complex::build_interpolators(
     error(__func__, __FILE__, __LINE__, "mismatched dreal, dimag, or u.", 1);
   for (size_t p = 0; p < m_.size(); p++) {
     std::slice index_range(p*u.size(), u.size(), 1);
-    Areal_[p] = ifactory->interpolate_data(
-        dblock_adapter(u), dblock_adapter<narray_t>(dreal[index_range]));
-    Aimag_[p] = ifactory->interpolate_data(
-        dblock_adapter(u), dblock_adapter<narray_t>(dimag[index_range]));
+    Areal_[p] = ifactory->interpolate_strided(
+        dblock_adapter(u), dblock_strided(dreal, index_range));
+    Aimag_[p] = ifactory->interpolate_strided(
+        dblock_adapter(u), dblock_strided(dimag, index_range));
   }
 }
 
@@ -22,6 +22,9 @@
 
 #include <gyronimo/core/dblock.hh>
 
+#include <span>
+#include <vector>
+
 namespace gyronimo {
 
 //! Access interface for 1d interpolators.
@@ -52,13 +55,32 @@ class interpolator1d {
     benefit from this level of abstraction, every interpolator class derived
     from interpolator1d **must** have a corresponding class derived from
     `interpolator1d_factory`.
+
+    Samples that are not contiguous in memory (e.g., a column of a 2d array)
+    are passed to `interpolate_strided`, which by default forwards contiguous
+    views untouched and gathers strided ones into a per-thread buffer, reused
+    across calls. Factories able to read strided samples in place may override
+    it.
 */
 class interpolator1d_factory {
  public:
   virtual interpolator1d* interpolate_data(
       const dblock& x_range, const dblock& y_range) const = 0;
+  virtual interpolator1d* interpolate_strided(
+      const dblock& x_range, const dblock_strided& y_range) const;
 };
 
+inline interpolator1d* interpolator1d_factory::interpolate_strided(
+    const dblock& x_range, const dblock_strided& y_range) const {
+  if (y_range.is_contiguous()) {
+    std::span<const double> samples(y_range.data(), y_range.size());
+    return this->interpolate_data(x_range, dblock_adapter(samples));
+  }
+  thread_local std::vector<double> buffer;
+  buffer.assign(y_range.begin(), y_range.end());
+  return this->interpolate_data(x_range, dblock_adapter(buffer));
+}
+
 } // end namespace gyronimo.
 
 #endif // GYRONIMO_INTERPOLATOR1D
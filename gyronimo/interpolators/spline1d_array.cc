@@ -0,0 +1,160 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @spline1d_array.cc, this file is part of ::gyronimo::
+
+#include <gyronimo/core/error.hh>
+#include <gyronimo/interpolators/spline1d_array.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace gyronimo {
+
+//! Stores the cubic coefficients of each `splines` element on every cell.
+/*!
+    The coefficients @f$a_k@f$ of @f$\sum_k a_k (x - x_j)^k@f$ on cell `j`
+    follow from the Hermite conditions on values and first derivatives at
+    both ends of the cell.
+*/
+spline1d_array::spline1d_array(
+    const dblock& x_range, std::span<const interpolator1d* const> splines)
+    : x_(x_range.begin(), x_range.end()), size_(splines.size()),
+      coefficients_(4 * splines.size() * (x_range.size() - 1)),
+      table_(coefficients_.data()), built_(true) {
+  if (x_.size() < 2)
+    error(__func__, __FILE__, __LINE__, " grid too small.", 1);
+  for (size_t i = 0; i < size_; i++) this->store(i, *splines[i]);
+}
+
+//! Builds the `size` interpolators with `builder`, now or on first use.
+spline1d_array::spline1d_array(
+    const dblock& x_range, size_t size, builder_t builder, bool lazy)
+    : x_(x_range.begin(), x_range.end()), size_(size),
+      table_(nullptr), builder_(std::move(builder)), built_(false) {
+  if (x_.size() < 2)
+    error(__func__, __FILE__, __LINE__, " grid too small.", 1);
+  if (!lazy) this->build();
+}
+
+//! Refers to the grid and coefficients stored as `name` in `s`, in place.
+spline1d_array::spline1d_array(const snapshot& s, const std::string& name)
+    : x_(s[name + ".grid"].begin(), s[name + ".grid"].end()),
+      size_(x_.size() < 2 ?
+          0 : s[name + ".coefficients"].size() / (4 * (x_.size() - 1))),
+      table_(s[name + ".coefficients"].data()), built_(true) {
+  if (x_.size() < 2 ||
+      s[name + ".coefficients"].size() != 4 * size_ * (x_.size() - 1))
+    error(__func__, __FILE__, __LINE__, " bad snapshot of " + name, 1);
+}
+
+//! Adds the grid and coefficients to `w` as `name.grid`, `name.coefficients`.
+void spline1d_array::save(snapshot::writer& w, const std::string& name) const {
+  if (!this->is_built()) this->build();
+  w.add(name + ".grid", x_);
+  w.add(name + ".coefficients", {table_, 4 * size_ * (x_.size() - 1)});
+}
+
+//! Calls `builder_` for all interpolators, spread over a pool of threads.
+void spline1d_array::build() const {
+  std::call_once(once_, [this]() {
+    coefficients_.resize(4 * size_ * (x_.size() - 1));
+    constexpr size_t min_batch = 32;  // below this, spawning costs more.
+    size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    size_t threads = std::clamp<size_t>(size_ / min_batch, 1, cores);
+    if (threads == 1)
+      for (size_t i = 0; i < size_; i++) this->store(i, *builder_(i));
+    else {
+      std::vector<std::jthread> pool;
+      for (size_t k = 0; k < threads; k++)
+        pool.emplace_back([this, k, threads]() {
+          size_t first = k * size_ / threads, last = (k + 1) * size_ / threads;
+          for (size_t i = first; i < last; i++) this->store(i, *builder_(i));
+        });
+    }  // std::jthread joins all workers on destruction.
+    builder_ = nullptr;
+    table_ = coefficients_.data();
+    built_.store(true, std::memory_order_release);
+  });
+}
+
+//! Hermite coefficients of the `i`-th interpolator `f` on every cell.
+/*!
+    Aborts if `f` is not a piecewise cubic with knots at the grid points (e.g.,
+    a `bspline3_boost` on a non-uniform grid), detected by comparing `f` and
+    the stored cubic at the middle of each cell.
+*/
+void spline1d_array::store(size_t i, const interpolator1d& f) const {
+  constexpr double tolerance = 1e-8;
+  double y0 = f(x_[0]), d0 = f.derivative(x_[0]);
+  for (size_t j = 0; j < x_.size() - 1; j++) {
+    double y1 = f(x_[j + 1]), d1 = f.derivative(x_[j + 1]);
+    double h = x_[j + 1] - x_[j], slope = (y1 - y0) / h;
+    double* a = coefficients_.data() + 4 * size_ * j + i;
+    a[0] = y0;
+    a[size_] = d0;
+    a[2 * size_] = (3 * slope - 2 * d0 - d1) / h;
+    a[3 * size_] = (d0 + d1 - 2 * slope) / (h * h);
+    double t = 0.5 * h, middle = f(x_[j] + t);
+    double cubic =
+        a[0] + t * (a[size_] + t * (a[2 * size_] + t * a[3 * size_]));
+    double scale = std::max(
+        {std::abs(y0), std::abs(y1), std::abs(h * d0), std::abs(h * d1)});
+    if (!(std::abs(middle - cubic) <= tolerance * scale))
+      error(__func__, __FILE__, __LINE__,
+            " not a piecewise cubic with knots on the grid.", 1);
+    y0 = y1;
+    d0 = d1;
+  }
+}
+
+//! Index `j` of the cell with `x_range[j] <= x < x_range[j + 1]`.
+/*!
+    Values of `x` outside the grid are assigned to the first or last cells.
+*/
+size_t spline1d_array::cell(double x) const {
+  auto upper = std::upper_bound(x_.begin(), x_.end(), x);
+  size_t j = (upper == x_.begin() ? 0 : upper - x_.begin() - 1);
+  return std::min(j, x_.size() - 2);
+}
+
+//! Values and derivatives of all interpolators at `x`, within `cell`.
+const spline1d_array::values_t& spline1d_array::operator()(
+    double x, size_t cell) const {
+  values_t& v = values_.local();
+  if (x == v.x && cell == v.cell) return v;
+  v.f.resize(size_);
+  v.df.resize(size_);
+  v.d2f.resize(size_);
+  const double* a = this->block(cell);
+  const double *a1 = a + size_, *a2 = a + 2 * size_, *a3 = a + 3 * size_;
+  double t = x - x_[cell];
+  double* f = v.f.data();
+  double* df = v.df.data();
+  double* d2f = v.d2f.data();
+  for (size_t i = 0; i < size_; i++) {
+    f[i] = a[i] + t * (a1[i] + t * (a2[i] + t * a3[i]));
+    df[i] = a1[i] + t * (2 * a2[i] + 3 * t * a3[i]);
+    d2f[i] = 2 * a2[i] + 6 * t * a3[i];
+  }
+  v.x = x;
+  v.cell = cell;
+  return v;
+}
+
+} // end namespace gyronimo.
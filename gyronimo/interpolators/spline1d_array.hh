@@ -0,0 +1,122 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @spline1d_array.hh, this file is part of ::gyronimo::
+
+#ifndef GYRONIMO_SPLINE1D_ARRAY
+#define GYRONIMO_SPLINE1D_ARRAY
+
+#include <gyronimo/core/per_thread.hh>
+#include <gyronimo/core/snapshot.hh>
+#include <gyronimo/interpolators/interpolator1d.hh>
+
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace gyronimo {
+
+//! Fused evaluation of many piecewise-cubic 1d interpolators on a common grid.
+/*!
+    Built from a set of `interpolator1d` objects sharing the same `x_range`,
+    whose values and first derivatives at the grid points are used to store
+    each cell's cubic polynomial in contiguous memory (cell-major, interpolator
+    minor). The representation is exact (up to roundoff) for every interpolator
+    that is a @f$C^1@f$ piecewise cubic with knots at the grid points (i.e.,
+    all GSL-based ones, `akima_boost` and `bspline3_boost` on uniform grids),
+    and the original objects may be discarded after construction. Other
+    interpolators abort the construction, each one being checked against its
+    stored cubic at the middle of every cell. A call to
+    `operator()` finds the cell once and sweeps all interpolators in a single
+    vectorisable loop, yielding values and first and second derivatives; the
+    result is memoised per thread (and per instance) until either `x` or the
+    cell changes. Values of `x` outside the grid are extrapolated from the
+    first and last cells.
+
+    Alternatively, the object may be built from a `builder` returning the `i`-th
+    interpolator, which is called concurrently for different `i` by a pool of
+    threads (one per 32 interpolators, up to the number of cores), each
+    interpolator being discarded as soon as its coefficients are stored. In
+    `lazy` mode, this construction is deferred until the first evaluation (and
+    done only once, even if several threads get there at the same time),
+    whatever is captured by `builder` having to remain valid until then. The
+    coefficients do not depend on the mode nor on the number of threads.
+
+    The grid and coefficients may be added to a `snapshot` by `save()` and
+    restored by the constructor taking the `snapshot`, in which case the
+    coefficients are read in place from the mapped file (which must thus
+    outlive this object) and nothing is recomputed.
+*/
+class spline1d_array {
+ public:
+  struct values_t {
+    double x = std::numeric_limits<double>::quiet_NaN();
+    size_t cell = 0;
+    std::vector<double> f, df, d2f;
+  };
+  using builder_t = std::function<std::unique_ptr<interpolator1d>(size_t)>;
+  spline1d_array(
+      const dblock& x_range, std::span<const interpolator1d* const> splines);
+  spline1d_array(
+      const dblock& x_range, size_t size, builder_t builder,
+      bool lazy = false);
+  spline1d_array(const snapshot& s, const std::string& name);
+  ~spline1d_array() {};
+
+  size_t size() const { return size_; };
+  size_t cell(double x) const;
+  const values_t& operator()(double x, size_t cell) const;
+  const values_t& operator()(double x) const { return (*this)(x, cell(x)); };
+  void evaluate(size_t i, size_t cell, double x, double out[3]) const;
+  bool is_built() const { return built_.load(std::memory_order_acquire); };
+  std::span<const double> grid() const { return x_; };
+  void save(snapshot::writer& w, const std::string& name) const;
+ private:
+  const std::vector<double> x_;
+  const size_t size_;
+  mutable std::vector<double> coefficients_;
+  mutable const double* table_;  // coefficients_ or mapped from a snapshot.
+  mutable builder_t builder_;
+  mutable std::once_flag once_;
+  mutable std::atomic<bool> built_;
+  per_thread<values_t> values_;
+  void build() const;
+  void store(size_t i, const interpolator1d& f) const;
+  const double* block(size_t cell) const {
+    if (!this->is_built()) this->build();
+    return table_ + 4 * size_ * cell;
+  };
+};
+
+//! Value and derivatives of the `i`-th interpolator alone, in `cell`.
+inline void spline1d_array::evaluate(
+    size_t i, size_t cell, double x, double out[3]) const {
+  const double* a = this->block(cell) + i;
+  double t = x - x_[cell];
+  double a0 = a[0], a1 = a[size_], a2 = a[2 * size_], a3 = a[3 * size_];
+  out[0] = a0 + t * (a1 + t * (a2 + t * a3));
+  out[1] = a1 + t * (2 * a2 + 3 * t * a3);
+  out[2] = 2 * a2 + 6 * t * a3;
+}
+
+} // end namespace gyronimo.
+
+#endif // GYRONIMO_SPLINE1D_ARRAY
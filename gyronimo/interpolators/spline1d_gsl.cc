@@ -22,20 +22,16 @@
 
 namespace gyronimo {
 
-spline1d_gsl::spline1d_gsl() : spline_(nullptr), acc_(nullptr) {
-  acc_ = gsl_interp_accel_alloc();
-}
-spline1d_gsl::~spline1d_gsl() {
-  if (acc_) delete(acc_);
-}
+spline1d_gsl::spline1d_gsl() : spline_(nullptr) {}
+spline1d_gsl::~spline1d_gsl() {}
 double spline1d_gsl::operator()(double x) const {
-  return gsl_spline_eval(spline_, x, acc_);
+  return gsl_spline_eval(spline_, x, this->accelerator());
 }
 double spline1d_gsl::derivative(double x) const {
-  return  gsl_spline_eval_deriv(spline_, x, acc_);
+  return  gsl_spline_eval_deriv(spline_, x, this->accelerator());
 }
 double spline1d_gsl::derivative2(double x) const {
-  return  gsl_spline_eval_deriv2(spline_, x, acc_);
+  return  gsl_spline_eval_deriv2(spline_, x, this->accelerator());
 }
 
 } // end namespace gyronimo.
@@ -26,6 +26,14 @@
 namespace gyronimo {
 
 //! Base class for 1d splines by [GSL](https://www.gnu.org/software/gsl).
+/*!
+    Evaluations are safe for concurrent readers: the GSL accelerator caching
+    the last grid cell is a `thread_local` object shared by all splines in the
+    same thread, rather than a member mutated by `const` functions. The cached
+    cell is just a hint (clamped to each spline's grid before use), thus
+    sequential queries along an orbit keep the speedup, as do splines sharing
+    the same grid and evaluated at the same point (e.g., Fourier harmonics).
+*/
 class spline1d_gsl : public interpolator1d {
  public:
   spline1d_gsl();
@@ -37,9 +45,17 @@ class spline1d_gsl : public interpolator1d {
 
  protected:
   gsl_spline *spline_;
-  gsl_interp_accel *acc_;
+ private:
+  gsl_interp_accel* accelerator() const;
 };
 
+//! Per-thread accelerator, with its cached cell valid for this spline's grid.
+inline gsl_interp_accel* spline1d_gsl::accelerator() const {
+  thread_local gsl_interp_accel acc = {0, 0, 0};
+  if (acc.cache + 2 > spline_->size) acc.cache = 0;
+  return &acc;
+}
+
 } // end namespace gyronimo.
 
 #endif // GYRONIMO_SPLINE1D_GSL
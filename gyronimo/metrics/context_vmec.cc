@@ -0,0 +1,247 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @context_vmec.cc, this file is part of ::gyronimo::
+
+#include <gyronimo/core/dblock.hh>
+#include <gyronimo/core/error.hh>
+#include <gyronimo/metrics/context_vmec.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numbers>
+
+namespace gyronimo {
+
+//! Concatenation of two `narray_type` arrays.
+context_vmec::narray_type context_vmec::concatenate(
+    const narray_type& x, const narray_type& y) {
+  narray_type xy(x.size() + y.size());
+  std::copy(std::begin(x), std::end(x), std::begin(xy));
+  std::copy(std::begin(y), std::end(y), std::begin(xy) + x.size());
+  return xy;
+}
+
+context_vmec::context_vmec(const parser_vmec* parser, bool symmetry)
+    : parser_(parser), harmonics_(parser->mnmax()),
+      harmonics_nyq_(parser->mnmax_nyq()), symmetry_(symmetry),
+      period_(2 * std::numbers::pi / parser->nfp()),
+      phases_(
+          concatenate(parser->xm(), parser->xm_nyq()),
+          concatenate(parser->xn(), parser->xn_nyq())) {
+  if (symmetry_ && parser->is_axisymmetric())  // holds VMEC's lasym flag.
+    error(__func__, __FILE__, __LINE__, " non-symmetric equilibrium.", 1);
+}
+
+//! Angles in the fundamental domain and the parity of the phase factors.
+/*!
+    The toroidal angle is first shifted by a whole number of field periods
+    into @f$[0,2\pi/N_{fp})@f$ and, if past half period, reflected together
+    with the poloidal angle, in which case `parity` is -1. Returns the
+    original angles with unit parity if symmetry reduction is disabled.
+*/
+context_vmec::reduced_t context_vmec::reduce(double theta, double zeta) const {
+  if (!symmetry_) return {theta, zeta, 1.0};
+  constexpr double two_pi = 2 * std::numbers::pi;
+  double zeta_r = zeta - period_ * std::floor(zeta / period_);
+  double theta_r = theta - two_pi * std::floor(theta / two_pi);
+  if (2 * zeta_r <= period_) return {theta_r, zeta_r, 1.0};
+  return {(theta_r > 0 ? two_pi - theta_r : 0.0), period_ - zeta_r, -1.0};
+}
+
+//! Harmonics with amplitude above `tolerance`, and the truncation error bound.
+/*!
+    Each element of `series` is a `parser_vmec` accessor of a `VMEC` array of
+    Fourier amplitudes (e.g., `&parser_vmec::rmnc`) with `harmonics` entries
+    per flux surface, read in place and divided by `divisor`. The amplitude of
+    a harmonic is its largest absolute value over all surfaces and all
+    `series`, and harmonics with amplitude below `tolerance` are dropped.
+    Returns the indices of the retained harmonics and the sum of the
+    amplitudes of the dropped ones, which bounds the error of each truncated
+    series (at the radial grid points). A null `tolerance` keeps everything,
+    without reading the arrays.
+*/
+std::pair<std::vector<size_t>, double> context_vmec::retained_modes(
+    std::initializer_list<series_t> series, size_t harmonics, double divisor,
+    double tolerance) const {
+  std::vector<double> amplitude(harmonics, 0.0);
+  if (tolerance > 0)
+    for (series_t accessor : series) {
+      const narray_type& samples_array = (parser_->*accessor)();
+      for (size_t k = 0; k < samples_array.size(); k++) {
+        double& a = amplitude[k % harmonics];
+        a = std::max(a, std::abs(samples_array[k] / divisor));
+      }
+    }
+  std::vector<size_t> modes;
+  double error_bound = 0;
+  for (size_t i = 0; i < harmonics; i++)
+    if (amplitude[i] >= tolerance) modes.push_back(i);
+    else error_bound += amplitude[i];
+  return {modes, error_bound};
+}
+
+//! Radial splines of the `modes` harmonics of all `series`, in this order.
+/*!
+    Each harmonic of each `VMEC` array returned by the `parser_vmec` accessors
+    in `series` (e.g., `&parser_vmec::rmnc`), divided by `divisor`, is
+    interpolated by an object built by `ifactory`, whose piecewise cubics are
+    copied into the returned `spline1d_array`. Full-mesh arrays are
+    interpolated on `sgrid`. If `half_mesh` is set (e.g., `gmnc`, `bmnc`),
+    the array is taken on `sgrid_half_cell` instead, its first row (which
+    `VMEC` leaves unused) being dropped, and values of `s` off the half mesh
+    are extrapolated from its end cells (see `half_cell()`). The interpolators
+    are built in parallel, either now or on first use if `lazy` is set (in
+    which case `ifactory` must remain valid until then). The builder holds
+    only the accessors, the arrays being read in place when the splines are
+    built (the samples of a single harmonic being copied if `divisor` is not
+    one).
+*/
+spline1d_array context_vmec::radial_splines(
+    std::vector<series_t> series, std::vector<size_t> modes, double divisor,
+    bool half_mesh, const interpolator1d_factory* ifactory, bool lazy) const {
+  size_t size = series.size() * modes.size();
+  auto builder = [parser = parser_, series = std::move(series),
+                  modes = std::move(modes), divisor, half_mesh,
+                  ifactory](size_t k) {
+    const narray_type& grid =
+        (half_mesh ? parser->sgrid_half_cell() : parser->sgrid());
+    const narray_type& samples_array = (parser->*series[k / modes.size()])();
+    size_t harmonics = samples_array.size() / parser->sgrid().size();
+    size_t first_row = (half_mesh ? harmonics : 0);
+    std::slice mask_k(
+        first_row + modes[k % modes.size()], grid.size(), harmonics);
+    dblock_strided samples(samples_array, mask_k);
+    if (divisor == 1)
+      return std::unique_ptr<interpolator1d>(
+          ifactory->interpolate_strided(dblock_adapter(grid), samples));
+    std::vector<double> column(samples.begin(), samples.end());
+    for (double& x : column) x /= divisor;
+    return std::unique_ptr<interpolator1d>(ifactory->interpolate_strided(
+        dblock_adapter(grid), dblock_strided(column.data(), column.size())));
+  };
+  return spline1d_array(
+      dblock_adapter(half_mesh ? parser_->sgrid_half_cell() : parser_->sgrid()),
+      size, std::move(builder), lazy);
+}
+
+//! Adds the retained harmonics and the truncation error to `w` as `name.*`.
+void context_vmec::save_truncation(
+    snapshot::writer& w, const std::string& name,
+    const std::pair<std::vector<size_t>, double>& truncation) const {
+  std::vector<double> modes(
+      truncation.first.begin(), truncation.first.end());
+  w.add(name + ".fingerprint", this->fingerprint());
+  w.add(name + ".modes", modes);
+  w.add(name + ".truncation", truncation.second);
+}
+
+//! Retained harmonics and truncation error stored as `name.*` in `s`.
+/*!
+    Aborts if the snapshot was saved from another equilibrium or if any of
+    its harmonics is not below `harmonics`.
+*/
+std::pair<std::vector<size_t>, double> context_vmec::restore_truncation(
+    const snapshot& s, const std::string& name, size_t harmonics) const {
+  if (!std::ranges::equal(s[name + ".fingerprint"], this->fingerprint()))
+    error(__func__, __FILE__, __LINE__, " snapshot of another file.", 1);
+  std::span<const double> modes = s[name + ".modes"];
+  if (std::ranges::any_of(modes, [harmonics](double k) {
+        return !(k >= 0 && k < harmonics);
+      }))
+    error(__func__, __FILE__, __LINE__, " bad snapshot harmonics.", 1);
+  return {{modes.begin(), modes.end()}, s[name + ".truncation"][0]};
+}
+
+//! Resolution and scalars identifying the parsed `VMEC` equilibrium.
+std::vector<double> context_vmec::fingerprint() const {
+  return {
+      double(parser_->ns()), double(parser_->nfp()),
+      double(parser_->mnmax()), double(parser_->mnmax_nyq()),
+      double(parser_->signgs()), parser_->B0(), parser_->rbtor0(),
+      parser_->volume()};
+}
+
+//! Index `j` of the `sgrid` cell with `sgrid[j] <= s < sgrid[j + 1]`.
+size_t context_vmec::cell(double s) const {
+  point_t& p = point_.local();
+  if (s != p.s) {
+    p.cell = grid_cell(parser_->sgrid(), s);
+    p.s = s;
+  }
+  return p.cell;
+}
+
+//! Index of the `sgrid_half_cell` cell containing `s`, as in `cell()`.
+size_t context_vmec::half_cell(double s) const {
+  point_t& p = point_.local();
+  if (s != p.s_half) {
+    p.half_cell = grid_cell(parser_->sgrid_half_cell(), s);
+    p.s_half = s;
+  }
+  return p.half_cell;
+}
+
+//! Index `j` of the `grid` cell with `grid[j] <= s < grid[j + 1]`.
+/*!
+    Values of `s` outside the grid are assigned to the first or last cells.
+*/
+size_t context_vmec::grid_cell(const narray_type& grid, double s) {
+  auto upper = std::upper_bound(std::begin(grid), std::end(grid), s);
+  size_t j = (upper == std::begin(grid) ? 0 : upper - std::begin(grid) - 1);
+  return std::min(j, grid.size() - 2);
+}
+
+//! Phase factors of the `modes` harmonics at all points of the chunk `q`.
+/*!
+    The factors of each point come from `cis()` or, if `nyquist` is set,
+    `cis_nyq()`, at the original (unreduced) angles. The factor of the `k`-th
+    element of `modes` at the `p`-th point is stored at index `k * q.size() +
+    p` of the returned span, which remains valid until the calling thread
+    gathers another chunk. Aborts if `q` holds more than `chunk_size` points.
+*/
+context_vmec::cis_span_t context_vmec::cis_batch(
+    const IR3span& q, std::span<const size_t> modes, bool nyquist) const {
+  size_t n = q.size();
+  if (n > chunk_size)
+    error(__func__, __FILE__, __LINE__, " chunk too large.", 1);
+  std::vector<std::complex<double>>& out = point_.local().chunk_cis;
+  out.resize(chunk_size * std::max(harmonics_, harmonics_nyq_));
+  for (size_t p = 0; p < n; p++) {
+    double theta = q.w()[p], zeta = q.v()[p];
+    cis_span_t cis_p =
+        (nyquist ? this->cis_nyq(theta, zeta) : this->cis(theta, zeta));
+    for (size_t k = 0; k < modes.size(); k++) out[k * n + p] = cis_p[modes[k]];
+  }
+  return cis_span_t(out).first(modes.size() * n);
+}
+
+//! Refills the calling thread's phase tables if the angles have changed.
+const context_vmec::point_t& context_vmec::update_phases(
+    double theta, double zeta) const {
+  point_t& p = point_.local();
+  if (theta != p.theta || zeta != p.zeta) {
+    p.cis.resize(phases_.size());
+    phases_(theta, zeta, p.cis);
+    p.theta = theta;
+    p.zeta = zeta;
+  }
+  return p;
+}
+
+}  // end namespace gyronimo.
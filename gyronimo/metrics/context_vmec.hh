@@ -0,0 +1,144 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @context_vmec.hh, this file is part of ::gyronimo::
+
+#ifndef GYRONIMO_CONTEXT_VMEC
+#define GYRONIMO_CONTEXT_VMEC
+
+#include <gyronimo/core/IR3span.hh>
+#include <gyronimo/core/fourier_phases.hh>
+#include <gyronimo/core/per_thread.hh>
+#include <gyronimo/core/snapshot.hh>
+#include <gyronimo/interpolators/interpolator1d.hh>
+#include <gyronimo/interpolators/spline1d_array.hh>
+#include <gyronimo/parsers/parser_vmec.hh>
+
+#include <complex>
+#include <limits>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gyronimo {
+
+//! Per-thread evaluation context shared by all `VMEC` objects.
+/*!
+    Holds, for the last point evaluated by each thread, the phase factors
+    @f$e^{i(m\theta - n\zeta)}@f$ of both the `xm`/`xn` (`cis()`) and the
+    `xm_nyq`/`xn_nyq` (`cis_nyq()`) harmonics, and the indices of the radial
+    cells containing the flux `s` in both the full mesh `sgrid` (`cell()`) and
+    the half mesh `sgrid_half_cell` (`half_cell()`). Both phase tables are
+    filled together, from a single `fourier_phases` pass, whenever either
+    angle changes. A `context_vmec` is owned by `morphism_vmec` and used by the
+    `metric_vmec` and `equilibrium_vmec` objects built on top of it, such that
+    a dynamical-system evaluation at a given point does the trigonometry and
+    the radial cell search only once. The returned references remain valid
+    until the same thread queries another point. Batched evaluations process
+    their points in chunks of at most `chunk_size`, `cis_batch()` gathering
+    the phase factors of a whole chunk into another per-thread buffer of fixed
+    size.
+
+    If built with `symmetry` set, `reduce()` maps the angles into the
+    fundamental domain @f$0 \le \zeta \le \pi/N_{fp}@f$ of a
+    stellarator-symmetric equilibrium. Field periodicity leaves the phase
+    factors unchanged and stellarator symmetry (i.e., @f$(\theta,\zeta)
+    \rightarrow (-\theta,-\zeta)@f$) conjugates them, such that `VMEC` objects
+    evaluating the phases at the reduced angles and multiplying their
+    imaginary parts by the returned `parity` recover the phases at the
+    original point. Phase caches then only cover @f$1/(2N_{fp})@f$ of the
+    torus and points related by symmetry share the same entries. Otherwise,
+    `reduce()` returns the angles unchanged with unit parity.
+
+    The `VMEC` objects saving their state to a `snapshot` store the retained
+    harmonics with `save_truncation()`, together with the `fingerprint()` of
+    the equilibrium (resolution and a few scalars), which `restore_truncation()`
+    checks against the parser at hand before returning the harmonics.
+*/
+class context_vmec {
+ public:
+  using narray_type = parser_vmec::narray_type;
+  using cis_span_t = std::span<const std::complex<double>>;
+  using series_t = const narray_type& (parser_vmec::*)() const;
+  context_vmec(const parser_vmec* parser, bool symmetry = false);
+  ~context_vmec() {};
+
+  cis_span_t cis(double theta, double zeta) const;
+  cis_span_t cis_nyq(double theta, double zeta) const;
+  size_t cell(double s) const;
+  size_t half_cell(double s) const;
+
+  static constexpr size_t chunk_size = 16;
+  cis_span_t cis_batch(
+      const IR3span& q, std::span<const size_t> modes, bool nyquist) const;
+
+  struct reduced_t { double theta, zeta, parity; };
+  reduced_t reduce(double theta, double zeta) const;
+
+  size_t harmonics() const { return harmonics_; };
+  size_t harmonics_nyq() const { return harmonics_nyq_; };
+  const parser_vmec* my_parser() const { return parser_; };
+  bool symmetry() const { return symmetry_; };
+
+  std::pair<std::vector<size_t>, double> retained_modes(
+      std::initializer_list<series_t> series, size_t harmonics,
+      double divisor, double tolerance) const;
+  spline1d_array radial_splines(
+      std::vector<series_t> series, std::vector<size_t> modes,
+      double divisor, bool half_mesh, const interpolator1d_factory* ifactory,
+      bool lazy) const;
+  std::vector<double> fingerprint() const;
+  void save_truncation(
+      snapshot::writer& w, const std::string& name,
+      const std::pair<std::vector<size_t>, double>& truncation) const;
+  std::pair<std::vector<size_t>, double> restore_truncation(
+      const snapshot& s, const std::string& name, size_t harmonics) const;
+ private:
+  struct point_t {
+    double theta = std::numeric_limits<double>::quiet_NaN();
+    double zeta = std::numeric_limits<double>::quiet_NaN();
+    double s = std::numeric_limits<double>::quiet_NaN();
+    double s_half = std::numeric_limits<double>::quiet_NaN();
+    size_t cell = 0, half_cell = 0;
+    std::vector<std::complex<double>> cis, chunk_cis;
+  };
+  const parser_vmec* parser_;
+  const size_t harmonics_, harmonics_nyq_;
+  const bool symmetry_;
+  const double period_;
+  const fourier_phases phases_;
+  per_thread<point_t> point_;
+
+  const point_t& update_phases(double theta, double zeta) const;
+  static narray_type concatenate(const narray_type& x, const narray_type& y);
+  static size_t grid_cell(const narray_type& grid, double s);
+};
+
+inline context_vmec::cis_span_t context_vmec::cis(
+    double theta, double zeta) const {
+  return cis_span_t(update_phases(theta, zeta).cis).first(harmonics_);
+}
+
+inline context_vmec::cis_span_t context_vmec::cis_nyq(
+    double theta, double zeta) const {
+  return cis_span_t(update_phases(theta, zeta).cis).last(harmonics_nyq_);
+}
+
+}  // end namespace gyronimo.
+
+#endif  // GYRONIMO_CONTEXT_VMEC
@@ -20,19 +20,29 @@
 #ifndef GYRONIMO_METRIC_CACHE
 #define GYRONIMO_METRIC_CACHE
 
+#include <gyronimo/core/multislot_cache.hh>
+#include <gyronimo/core/per_thread.hh>
 #include <gyronimo/metrics/metric_covariant.hh>
 
 namespace gyronimo {
 
 //! Cache layer over objects derived from `metric_covariant`.
 /*!
-    Defines a depth-1 cache layer (or a decorator) for all member functions
+    Defines a depth-`N` cache layer (or a decorator) for all member functions
     declared in the `metric_covariant` interface. Because it derives from its
     template argument, it can be used to replace pointers or references to
     objects of that type in client code. The cache object is constructed with
     the same constructor call as its template argument.
+
+    Each instance keeps its own cache in each thread (see `per_thread`), so
+    concurrent readers are safe and distinct instances of the same type never
+    evict each other's entries. Every member function remembers its `N` most
+    recent evaluations (see `multislot_cache`), the default being enough for
+    the four stages of a Runge-Kutta step, with the observer's sample point
+    hitting the first stage of the next step.
 */
-template<typename T> requires std::derived_from<T, metric_covariant>
+template<typename T, size_t N = 4>
+  requires std::derived_from<T, metric_covariant>
 class metric_cache : public T {
  public:
   template<typename... Args> metric_cache(Args... args) : T(args...) {};
@@ -48,104 +58,98 @@ class metric_cache : public T {
   virtual IR3 inertial_force(const IR3& q, const IR3& dot_q) const override;
   virtual IR3 to_covariant(const IR3& B, const IR3& q) const override;
   virtual IR3 to_contravariant(const IR3& B, const IR3& q) const override;
+  virtual metric_covariant::metric_bundle bundle(
+      const IR3& q, bool christoffel = false) const override;
  private:
-  static inline IR3 un_init_ = {123456789., 987654321., 192837465.};
+  struct slots_t {
+    multislot_cache<N, SM3, IR3> eval;
+    multislot_cache<N, dSM3, IR3> del;
+    multislot_cache<N, double, IR3> jacobian;
+    multislot_cache<N, IR3, IR3> del_jacobian;
+    multislot_cache<N, SM3, IR3> inverse;
+    multislot_cache<N, dSM3, IR3> del_inverse;
+    multislot_cache<N, ddIR3, IR3> christoffel_first_kind;
+    multislot_cache<N, ddIR3, IR3> christoffel_second_kind;
+    multislot_cache<N, IR3, IR3, IR3> inertial_force;
+    multislot_cache<N, IR3, IR3, IR3> to_covariant;
+    multislot_cache<N, IR3, IR3, IR3> to_contravariant;
+    multislot_cache<N, metric_covariant::metric_bundle, IR3, bool> bundle;
+  };
+  per_thread<slots_t> slots_;
 };
 
-template<typename T> requires std::derived_from<T, metric_covariant>
-SM3 metric_cache<T>::operator()(const IR3& q) const {
-  thread_local IR3 cache_q = un_init_;
-  thread_local SM3 cache_eval = {0, 0, 0, 0, 0, 0};
-  if (q == cache_q) return cache_eval;
-  cache_q = q;
-  return cache_eval = T::operator()(q);
+template<typename T, size_t N> requires std::derived_from<T, metric_covariant>
+SM3 metric_cache<T, N>::operator()(const IR3& q) const {
+  auto& cache = slots_.local().eval;
+  if (auto hit = cache.find(q)) return *hit;
+  return cache.insert(T::operator()(q), q);
+}
+template<typename T, size_t N> requires std::derived_from<T, metric_covariant>
+dSM3 metric_cache<T, N>::del(const IR3& q) const {
+  auto& cache = slots_.local().del;
+  if (auto hit = cache.find(q)) return *hit;
+  return cache.insert(T::del(q), q);
 }
-template<typename T> requires std::derived_from<T, metric_covariant>
-dSM3 metric_cache<T>::del(const IR3& q) const {
-  thread_local IR3 cache_q = un_init_;
-  thread_local dSM3 cache_eval = {
-      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-  if (q == cache_q) return cache_eval;
-  cache_q = q;
-  return cache_eval = T::del(q);
+template<typename T, size_t N> requires std::derived_from<T, metric_covariant>
+double metric_cache<T, N>::jacobian(const IR3& q) const {
+  auto& cache = slots_.local().jacobian;
+  if (auto hit = cache.find(q)) return *hit;
+  return cache.insert(T::jacobian(q), q);
 }
-template<typename T> requires std::derived_from<T, metric_covariant>
-double metric_cache<T>::jacobian(const IR3& q) const {
-  thread_local IR3 cache_q = un_init_;
-  thread_local double cache_eval = 0;
-  if (q == cache_q) return cache_eval;
-  cache_q = q;
-  return cache_eval = T::jacobian(q);
+template<typename T, size_t N> requires std::derived_from<T, metric_covariant>
+IR3 metric_cache<T, N>::del_jacobian(const IR3& q) const {
+  auto& cache = slots_.local().del_jacobian;
+  if (auto hit = cache.find(q)) return *hit;
+  return cache.insert(T::del_jacobian(q), q);
 }
-template<typename T> requires std::derived_from<T, metric_covariant>
-IR3 metric_cache<T>::del_jacobian(const IR3& q) const {
-  thread_local IR3 cache_q = un_init_;
-  thread_local IR3 cache_eval = {0, 0, 0};
-  if (q == cache_q) return cache_eval;
-  cache_q = q;
-  return cache_eval = T::del_jacobian(q);
+template<typename T, size_t N> requires std::derived_from<T, metric_covariant>
+SM3 metric_cache<T, N>::inverse(const IR3& q) const {
+  auto& cache = slots_.local().inverse;
+  if (auto hit = cache.find(q)) return *hit;
+  return cache.insert(T::inverse(q), q);
 }
-template<typename T> requires std::derived_from<T, metric_covariant>
-SM3 metric_cache<T>::inverse(const IR3& q) const {
-  thread_local IR3 cache_q = un_init_;
-  thread_local SM3 cache_eval = {0, 0, 0, 0, 0, 0};
-  if (q == cache_q) return cache_eval;
-  cache_q = q;
-  return cache_eval = T::inverse(q);
+template<typename T, size_t N> requires std::derived_from<T, metric_covariant>
+dSM3 metric_cache<T, N>::del_inverse(const IR3& q) const {
+  auto& cache = slots_.local().del_inverse;
+  if (auto hit = cache.find(q)) return *hit;
+  return cache.insert(T::del_inverse(q), q);
 }
-template<typename T> requires std::derived_from<T, metric_covariant>
-dSM3 metric_cache<T>::del_inverse(const IR3& q) const {
-  thread_local IR3 cache_q = un_init_;
-  thread_local dSM3 cache_eval = {
-      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-  if (q == cache_q) return cache_eval;
-  cache_q = q;
-  return cache_eval = T::del_inverse(q);
+template<typename T, size_t N> requires std::derived_from<T, metric_covariant>
+ddIR3 metric_cache<T, N>::christoffel_first_kind(const IR3& q) const {
+  auto& cache = slots_.local().christoffel_first_kind;
+  if (auto hit = cache.find(q)) return *hit;
+  return cache.insert(T::christoffel_first_kind(q), q);
 }
-template<typename T> requires std::derived_from<T, metric_covariant>
-ddIR3 metric_cache<T>::christoffel_first_kind(const IR3& q) const {
-  thread_local IR3 cache_q = un_init_;
-  thread_local ddIR3 cache_eval = {
-      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-  if (q == cache_q) return cache_eval;
-  cache_q = q;
-  return cache_eval = T::christoffel_first_kind(q);
+template<typename T, size_t N> requires std::derived_from<T, metric_covariant>
+ddIR3 metric_cache<T, N>::christoffel_second_kind(const IR3& q) const {
+  auto& cache = slots_.local().christoffel_second_kind;
+  if (auto hit = cache.find(q)) return *hit;
+  return cache.insert(T::christoffel_second_kind(q), q);
 }
-template<typename T> requires std::derived_from<T, metric_covariant>
-ddIR3 metric_cache<T>::christoffel_second_kind(const IR3& q) const {
-  thread_local IR3 cache_q = un_init_;
-  thread_local ddIR3 cache_eval = {
-      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-  if (q == cache_q) return cache_eval;
-  cache_q = q;
-  return cache_eval = T::christoffel_second_kind(q);
+template<typename T, size_t N> requires std::derived_from<T, metric_covariant>
+IR3 metric_cache<T, N>::inertial_force(const IR3& q, const IR3& dot_q) const {
+  auto& cache = slots_.local().inertial_force;
+  if (auto hit = cache.find(q, dot_q)) return *hit;
+  return cache.insert(T::inertial_force(q, dot_q), q, dot_q);
 }
-template<typename T> requires std::derived_from<T, metric_covariant>
-IR3 metric_cache<T>::inertial_force(const IR3& q, const IR3& dot_q) const {
-  thread_local IR3 cache_q = un_init_, cache_dot_q = un_init_;
-  thread_local IR3 cache_eval = {0, 0, 0};
-  if (q == cache_q && dot_q == cache_dot_q) return cache_eval;
-  cache_q = q;
-  cache_dot_q = dot_q;
-  return cache_eval = T::inertial_force(q, dot_q);
+template<typename T, size_t N> requires std::derived_from<T, metric_covariant>
+IR3 metric_cache<T, N>::to_covariant(const IR3& B, const IR3& q) const {
+  auto& cache = slots_.local().to_covariant;
+  if (auto hit = cache.find(B, q)) return *hit;
+  return cache.insert(T::to_covariant(B, q), B, q);
 }
-template<typename T> requires std::derived_from<T, metric_covariant>
-IR3 metric_cache<T>::to_covariant(const IR3& B, const IR3& q) const {
-  thread_local IR3 cache_q = un_init_, cache_B = un_init_;
-  thread_local IR3 cache_eval = {0, 0, 0};
-  if (q == cache_q && B == cache_B) return cache_eval;
-  cache_q = q;
-  cache_B = B;
-  return cache_eval = T::to_covariant(B, q);
+template<typename T, size_t N> requires std::derived_from<T, metric_covariant>
+IR3 metric_cache<T, N>::to_contravariant(const IR3& B, const IR3& q) const {
+  auto& cache = slots_.local().to_contravariant;
+  if (auto hit = cache.find(B, q)) return *hit;
+  return cache.insert(T::to_contravariant(B, q), B, q);
 }
-template<typename T> requires std::derived_from<T, metric_covariant>
-IR3 metric_cache<T>::to_contravariant(const IR3& B, const IR3& q) const {
-  thread_local IR3 cache_q = un_init_, cache_B = un_init_;
-  thread_local IR3 cache_eval = {0, 0, 0};
-  if (q == cache_q && B == cache_B) return cache_eval;
-  cache_q = q;
-  cache_B = B;
-  return cache_eval = T::to_contravariant(B, q);
+template<typename T, size_t N> requires std::derived_from<T, metric_covariant>
+metric_covariant::metric_bundle metric_cache<T, N>::bundle(
+    const IR3& q, bool christoffel) const {
+  auto& cache = slots_.local().bundle;
+  if (auto hit = cache.find(q, christoffel)) return *hit;
+  return cache.insert(T::bundle(q, christoffel), q, christoffel);
 }
 
 }  // namespace gyronimo
@@ -48,6 +48,8 @@ class metric_calltrace : public T {
   virtual IR3 inertial_force(const IR3& q, const IR3& dot_q) const override;
   virtual IR3 to_covariant(const IR3& B, const IR3& q) const override;
   virtual IR3 to_contravariant(const IR3& B, const IR3& q) const override;
+  virtual metric_covariant::metric_bundle bundle(
+      const IR3& q, bool christoffel = false) const override;
 };
 
 template<typename T> requires std::derived_from<T, metric_covariant>
@@ -105,6 +107,12 @@ IR3 metric_calltrace<T>::to_contravariant(const IR3& B, const IR3& q) const {
   std::cout << "metric_covariant::to_contravariant(B, q)\n";
   return T::to_contravariant(B, q);
 }
+template<typename T> requires std::derived_from<T, metric_covariant>
+metric_covariant::metric_bundle metric_calltrace<T>::bundle(
+    const IR3& q, bool christoffel) const {
+  std::cout << "metric_covariant::bundle(q, christoffel)\n";
+  return T::bundle(q, christoffel);
+}
 
 }  // namespace gyronimo
 
@@ -25,7 +25,7 @@
 
 namespace gyronimo {
 
-//! Trivial covariant metric for cartesian space.
+//! Trivial covariant metric for cartesian space (with a trivial `bundle()`).
 class metric_cartesian : public metric_connected {
  public:
   metric_cartesian(const morphism_cartesian* m) : metric_connected(m) {};
@@ -42,6 +42,8 @@ class metric_cartesian : public metric_connected {
   virtual IR3 to_contravariant(const IR3& B, const IR3& q) const override;
   virtual IR3 inertial_force(
       const IR3& q, const IR3& dot_q) const override;
+  virtual metric_bundle bundle(
+      const IR3& q, bool christoffel = false) const override;
 
   const morphism_cartesian* my_morphism() const {
     return static_cast<const morphism_cartesian*>(
@@ -79,6 +81,14 @@ inline IR3 metric_cartesian::inertial_force(
     const IR3& q, const IR3& dot_q) const {
   return {0.0, 0.0, 0.0};
 }
+inline metric_covariant::metric_bundle metric_cartesian::bundle(
+    const IR3& q, bool christoffel) const {
+  return {
+      metric_cartesian::operator()(q), metric_cartesian::inverse(q), 1.0,
+      metric_cartesian::del(q), metric_cartesian::del_jacobian(q),
+      metric_cartesian::christoffel_first_kind(q),
+      metric_cartesian::christoffel_second_kind(q)};
+}
 inline IR3 metric_cartesian::to_covariant(const IR3& B, const IR3& q) const {
   return B;
 }
@@ -19,11 +19,28 @@
 
 #include <gyronimo/metrics/metric_connected.hh>
 
+#include <vector>
+
 namespace gyronimo {
 
 //! General covariant metric @f$g_{ij} = \mathbf{e}_i\cdot\mathbf{e}_j@f$.
 SM3 metric_connected::operator()(const IR3& q) const {
-  dIR3 e = my_morphism_->del(q);
+  return metric_connected::from_tangent_basis(my_morphism_->del(q));
+}
+
+//! Batched metric, built on a single `morphism::del_batch` call.
+void metric_connected::eval_batch(
+    const IR3span& q, std::span<SM3> out) const {
+  check_batch_size(q, out);
+  thread_local std::vector<dIR3> e;
+  if (e.size() < q.size()) e.resize(q.size());
+  my_morphism_->del_batch(q, e);
+  for (size_t i = 0; i < q.size(); i++)
+    out[i] = metric_connected::from_tangent_basis(e[i]);
+}
+
+//! Products @f$\mathbf{e}_i\cdot\mathbf{e}_j@f$ from the morphism derivatives.
+SM3 metric_connected::from_tangent_basis(const dIR3& e) {
   IR3 e1 = {e[dIR3::uu], e[dIR3::vu], e[dIR3::wu]};
   IR3 e2 = {e[dIR3::uv], e[dIR3::vv], e[dIR3::wv]};
   IR3 e3 = {e[dIR3::uw], e[dIR3::vw], e[dIR3::ww]};
@@ -32,9 +49,24 @@ SM3 metric_connected::operator()(const IR3& q) const {
   return g;
 }
 
+//! Products @f$\mathbf{e}^i\cdot\mathbf{e}^j@f$ from the inverse derivatives.
+SM3 metric_connected::from_dual_basis(const dIR3& ee) {
+  IR3 e1 = {ee[dIR3::uu], ee[dIR3::uv], ee[dIR3::uw]};
+  IR3 e2 = {ee[dIR3::vu], ee[dIR3::vv], ee[dIR3::vw]};
+  IR3 e3 = {ee[dIR3::wu], ee[dIR3::wv], ee[dIR3::ww]};
+  SM3 g = {inner_product(e1, e1), inner_product(e1, e2), inner_product(e1, e3),
+           inner_product(e2, e2), inner_product(e2, e3), inner_product(e3, e3)};
+  return g;
+}
+
 //! Metric derivatives via @f$\partial_k g_{ij}=\Gamma_{ijk}+\Gamma_{jik}@f$.
 dSM3 metric_connected::del(const IR3& q) const {
-  ddIR3 gamma = this->christoffel_first_kind(q);
+  return metric_connected::del_from_christoffel(
+      this->christoffel_first_kind(q));
+}
+
+//! Metric derivatives from the Christoffel symbols @f$\Gamma_{ijk}@f$.
+dSM3 metric_connected::del_from_christoffel(const ddIR3& gamma) {
   return {
       gamma[ddIR3::uuu] + gamma[ddIR3::uuu],  // uuu
       gamma[ddIR3::uuv] + gamma[ddIR3::uuv],  // uuv
@@ -59,9 +91,15 @@ dSM3 metric_connected::del(const IR3& q) const {
 
 //! Jacobian gradient via @f$J^{-1} \partial_i J = \Gamma^j_{ij}@f$.
 IR3 metric_connected::del_jacobian(const IR3& q) const {
-  dIR3 ee = my_morphism_->del_inverse(q);
-  ddIR3 de = my_morphism_->ddel(q);
-  IR3 con = {
+  IR3 con = metric_connected::contracted_christoffel(
+      my_morphism_->del_inverse(q), my_morphism_->ddel(q));
+  return (jacobian(q) * con);
+}
+
+//! Contraction @f$\Gamma^j_{ij}@f$, from the morphism derivatives.
+IR3 metric_connected::contracted_christoffel(
+    const dIR3& ee, const ddIR3& de) {
+  return {
       ee[dIR3::uu] * de[ddIR3::uuu] + ee[dIR3::uv] * de[ddIR3::vuu] +
           ee[dIR3::uw] * de[ddIR3::wuu] + ee[dIR3::vu] * de[ddIR3::uuv] +
           ee[dIR3::vv] * de[ddIR3::vuv] + ee[dIR3::vw] * de[ddIR3::wuv] +
@@ -77,7 +115,38 @@ IR3 metric_connected::del_jacobian(const IR3& q) const {
           ee[dIR3::vv] * de[ddIR3::vvw] + ee[dIR3::vw] * de[ddIR3::wvw] +
           ee[dIR3::wu] * de[ddIR3::uww] + ee[dIR3::wv] * de[ddIR3::vww] +
           ee[dIR3::ww] * de[ddIR3::www]};
-  return (jacobian(q) * con);
+}
+
+//! Metric quantities from single calls to `morphism::del()` and `ddel()`.
+metric_covariant::metric_bundle metric_connected::bundle(
+    const IR3& q, bool christoffel) const {
+  return metric_connected::bundle_from_tangent_basis(
+      my_morphism_->del(q), my_morphism_->ddel(q), christoffel);
+}
+
+//! Builds a `metric_bundle` from the morphism derivatives `e` and `de`.
+/*!
+    The inverse metric follows from the dual basis @f$\mathbf{e}^i@f$ (i.e.,
+    the inverse of `e`), the metric derivatives and the jacobian gradient from
+    @f$\Gamma_{kij} = \mathbf{e}_k \cdot \partial^2_{ij}\mathbf{x}@f$ and
+    @f$\Gamma^k_{ij} = \mathbf{e}^k \cdot \partial^2_{ij}\mathbf{x}@f$,
+    the jacobian being the determinant of `e`.
+*/
+metric_covariant::metric_bundle metric_connected::bundle_from_tangent_basis(
+    const dIR3& e, const ddIR3& de, bool christoffel) {
+  dIR3 ee = gyronimo::inverse(e);
+  ddIR3 gamma = contraction<first>(e, de);
+  double jacobian = gyronimo::determinant(e);
+  metric_bundle b = {
+      metric_connected::from_tangent_basis(e),
+      metric_connected::from_dual_basis(ee), jacobian,
+      metric_connected::del_from_christoffel(gamma),
+      jacobian * metric_connected::contracted_christoffel(ee, de), {}, {}};
+  if (christoffel) {
+    b.christoffel_first_kind = gamma;
+    b.christoffel_second_kind = contraction<second>(ee, de);
+  }
+  return b;
 }
 
 }  // end namespace gyronimo.
@@ -37,7 +37,10 @@ namespace gyronimo {
     already a full functional (i.e., instantiable) object. However, it can be
     used as a parent for derived classes intended to override some of its member
     functions in order to have them specialised (and thus optimised) according
-    to the particular properties enjoyed by specific coordinate sets.
+    to the particular properties enjoyed by specific coordinate sets. The
+    batched metric and jacobian are built on the batched morphism derivatives,
+    thus inheriting any specialisation the latter may have. Likewise, `bundle()`
+    is built on single calls to `morphism::del()` and `morphism::ddel()`.
 */
 class metric_connected : public metric_covariant {
  public:
@@ -49,8 +52,21 @@ class metric_connected : public metric_covariant {
   virtual IR3 del_jacobian(const IR3& q) const override;
   virtual ddIR3 christoffel_first_kind(const IR3& q) const override;
   virtual ddIR3 christoffel_second_kind(const IR3& q) const override;
+  virtual metric_bundle bundle(
+      const IR3& q, bool christoffel = false) const override;
+  virtual void eval_batch(
+      const IR3span& q, std::span<SM3> out) const override;
+  virtual void jacobian_batch(
+      const IR3span& q, std::span<double> out) const override;
 
   const morphism* my_morphism() const { return my_morphism_; };
+ protected:
+  static metric_bundle bundle_from_tangent_basis(
+      const dIR3& e, const ddIR3& de, bool christoffel);
+  static SM3 from_tangent_basis(const dIR3& e);
+  static SM3 from_dual_basis(const dIR3& ee);
+  static dSM3 del_from_christoffel(const ddIR3& gamma);
+  static IR3 contracted_christoffel(const dIR3& ee, const ddIR3& de);
  private:
   const morphism* my_morphism_;
 };
@@ -60,6 +76,12 @@ inline double metric_connected::jacobian(const IR3& q) const {
   return my_morphism_->jacobian(q);
 }
 
+//! General-purpose batched jacobian, as inherited from parent `morphism`.
+inline void metric_connected::jacobian_batch(
+    const IR3span& q, std::span<double> out) const {
+  my_morphism_->jacobian_batch(q, out);
+}
+
 //! Christoffel @f$\Gamma_{kij}=\mathbf{e}_k\cdot\partial^2_{ij}\mathbf{x}@f$.
 inline ddIR3 metric_connected::christoffel_first_kind(const IR3& q) const {
   return contraction<first>(my_morphism_->del(q), my_morphism_->ddel(q));
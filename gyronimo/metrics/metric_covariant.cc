@@ -218,7 +218,11 @@ dSM3 metric_covariant::del_inverse(const IR3& q) const {
     \partial_j g_{ik} - \partial_i g_{jk}) @f$.
 */
 ddIR3 metric_covariant::christoffel_first_kind(const IR3& q) const {
-  dSM3 dg = del(q);
+  return metric_covariant::christoffel_from(this->del(q));
+}
+
+//! Christoffel symbols @f$\Gamma_{ijk}@f$ from the metric derivatives `dg`.
+ddIR3 metric_covariant::christoffel_from(const dSM3& dg) {
   return {
       0.5 * (dg[dSM3::uuu] + dg[dSM3::uuu] - dg[dSM3::uuu]),  // uuu
       0.5 * (dg[dSM3::uuv] + dg[dSM3::uvu] - dg[dSM3::uvu]),  // uuv
@@ -244,7 +248,18 @@ ddIR3 metric_covariant::christoffel_first_kind(const IR3& q) const {
 //! Inertial force @f$ F^k = - \Gamma^k_{ij} \, \dot{q}^i \, \dot{q}^j @f$.
 inline IR3 metric_covariant::inertial_force(
     const IR3& q, const IR3& dot_q) const {
-  ddIR3 gamma = christoffel_second_kind(q);
+  return metric_covariant::inertial_force_from(
+      this->christoffel_second_kind(q), dot_q);
+}
+
+//! Inertial force from the bundled Christoffel symbols (if requested).
+IR3 metric_covariant::metric_bundle::inertial_force(const IR3& dot_q) const {
+  return metric_covariant::inertial_force_from(
+      christoffel_second_kind, dot_q);
+}
+
+IR3 metric_covariant::inertial_force_from(
+    const ddIR3& gamma, const IR3& dot_q) {
   SM3 dq2 = {
       dot_q[IR3::u] * dot_q[IR3::u], dot_q[IR3::u] * dot_q[IR3::v],
       dot_q[IR3::u] * dot_q[IR3::w], dot_q[IR3::v] * dot_q[IR3::v],
@@ -262,4 +277,104 @@ inline IR3 metric_covariant::inertial_force(
  };
 }
 
+//! Metric quantities at `q`, from single calls to `operator()` and `del()`.
+/*!
+    The Christoffel symbols are only computed if `christoffel` is set, being
+    left zero otherwise.
+*/
+metric_covariant::metric_bundle metric_covariant::bundle(
+    const IR3& q, bool christoffel) const {
+  SM3 g = (*this)(q);
+  return metric_covariant::bundle_from(
+      g, this->del(q), std::sqrt(gyronimo::determinant(g)), christoffel);
+}
+
+//! Builds a `metric_bundle` from the metric `g` and its derivatives `dg`.
+/*!
+    The inverse is built from the cofactors of `g`, whilst the jacobian
+    gradient follows from @f$J^{-1}\partial_k J = \frac{1}{2} g^{ij}
+    \partial_k g_{ij}@f$, with the supplied `jacobian`. Each quantity is thus
+    evaluated only once.
+*/
+metric_covariant::metric_bundle metric_covariant::bundle_from(
+    const SM3& g, const dSM3& dg, double jacobian, bool christoffel) {
+  SM3 cofactor = {
+      g[SM3::vv]*g[SM3::ww] - g[SM3::vw]*g[SM3::vw],
+      g[SM3::uw]*g[SM3::vw] - g[SM3::uv]*g[SM3::ww],
+      g[SM3::uv]*g[SM3::vw] - g[SM3::uw]*g[SM3::vv],
+      g[SM3::uu]*g[SM3::ww] - g[SM3::uw]*g[SM3::uw],
+      g[SM3::uv]*g[SM3::uw] - g[SM3::uu]*g[SM3::vw],
+      g[SM3::uu]*g[SM3::vv] - g[SM3::uv]*g[SM3::uv]};
+  double ideterminant = 1.0/(
+      g[SM3::uu]*cofactor[SM3::uu] + g[SM3::uv]*cofactor[SM3::uv] +
+      g[SM3::uw]*cofactor[SM3::uw]);
+  SM3 ig = {
+      ideterminant*cofactor[SM3::uu], ideterminant*cofactor[SM3::uv],
+      ideterminant*cofactor[SM3::uw], ideterminant*cofactor[SM3::vv],
+      ideterminant*cofactor[SM3::vw], ideterminant*cofactor[SM3::ww]};
+  auto trace = [&ig, &dg](dSM3::index uu, dSM3::index uv, dSM3::index uw,
+                          dSM3::index vv, dSM3::index vw, dSM3::index ww) {
+    return ig[SM3::uu]*dg[uu] + ig[SM3::vv]*dg[vv] + ig[SM3::ww]*dg[ww] +
+        2*(ig[SM3::uv]*dg[uv] + ig[SM3::uw]*dg[uw] + ig[SM3::vw]*dg[vw]);
+  };
+  double half_jacobian = 0.5*jacobian;
+  IR3 del_jacobian = {
+      half_jacobian*trace(
+          dSM3::uuu, dSM3::uvu, dSM3::uwu, dSM3::vvu, dSM3::vwu, dSM3::wwu),
+      half_jacobian*trace(
+          dSM3::uuv, dSM3::uvv, dSM3::uwv, dSM3::vvv, dSM3::vwv, dSM3::wwv),
+      half_jacobian*trace(
+          dSM3::uuw, dSM3::uvw, dSM3::uww, dSM3::vvw, dSM3::vww, dSM3::www)};
+  metric_bundle b = {g, ig, jacobian, dg, del_jacobian, {}, {}};
+  if (christoffel) {
+    b.christoffel_first_kind = metric_covariant::christoffel_from(dg);
+    b.christoffel_second_kind =
+        contraction<first>(b.christoffel_first_kind, ig);
+  }
+  return b;
+}
+
+void metric_covariant::eval_batch(
+    const IR3span& q, std::span<SM3> out) const {
+  check_batch_size(q, out);
+  for (size_t i = 0; i < q.size(); i++) out[i] = (*this)(q[i]);
+}
+void metric_covariant::del_batch(
+    const IR3span& q, std::span<dSM3> out) const {
+  check_batch_size(q, out);
+  for (size_t i = 0; i < q.size(); i++) out[i] = this->del(q[i]);
+}
+void metric_covariant::jacobian_batch(
+    const IR3span& q, std::span<double> out) const {
+  check_batch_size(q, out);
+  for (size_t i = 0; i < q.size(); i++) out[i] = this->jacobian(q[i]);
+}
+void metric_covariant::del_jacobian_batch(
+    const IR3span& q, std::span<IR3> out) const {
+  check_batch_size(q, out);
+  for (size_t i = 0; i < q.size(); i++) out[i] = this->del_jacobian(q[i]);
+}
+void metric_covariant::inverse_batch(
+    const IR3span& q, std::span<SM3> out) const {
+  check_batch_size(q, out);
+  for (size_t i = 0; i < q.size(); i++) out[i] = this->inverse(q[i]);
+}
+void metric_covariant::del_inverse_batch(
+    const IR3span& q, std::span<dSM3> out) const {
+  check_batch_size(q, out);
+  for (size_t i = 0; i < q.size(); i++) out[i] = this->del_inverse(q[i]);
+}
+void metric_covariant::christoffel_first_kind_batch(
+    const IR3span& q, std::span<ddIR3> out) const {
+  check_batch_size(q, out);
+  for (size_t i = 0; i < q.size(); i++)
+    out[i] = this->christoffel_first_kind(q[i]);
+}
+void metric_covariant::christoffel_second_kind_batch(
+    const IR3span& q, std::span<ddIR3> out) const {
+  check_batch_size(q, out);
+  for (size_t i = 0; i < q.size(); i++)
+    out[i] = this->christoffel_second_kind(q[i]);
+}
+
 } // end namespace gyronimo.
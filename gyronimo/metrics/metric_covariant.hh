@@ -22,6 +22,7 @@
 
 #include <gyronimo/core/contraction.hh>
 #include <gyronimo/core/IR3algebra.hh>
+#include <gyronimo/core/IR3span.hh>
 #include <gyronimo/core/SM3algebra.hh>
 
 namespace gyronimo {
@@ -45,9 +46,30 @@ namespace gyronimo {
     Regarding units, all methods must ensure that @f$g_{ij} q^i q^j@f$ returns
     values in SI (m^2). **Atention**: the coordinates @f$ \{q^u, q^v, q^w\} @f$
     must be right-hand ordered to ensure a positive determinant.
+
+    Batched counterparts (e.g., `jacobian_batch`) evaluate a whole `IR3span`
+    of positions into caller-owned buffers, `eval_batch` standing for
+    `operator()`. By default they loop over the single-position functions.
+    Clients needing several metric quantities at the same position should call
+    `bundle()` instead, which returns all of them in a `metric_bundle` built
+    from a single evaluation of @f$g_{ij}@f$ and @f$\partial_k g_{ij}@f$.
 */
 class metric_covariant {
  public:
+  //! Metric, inverse, jacobian, and derivatives at a single position.
+  struct metric_bundle {
+    SM3 g, inverse;
+    double jacobian;
+    dSM3 del;
+    IR3 del_jacobian;
+    ddIR3 christoffel_first_kind, christoffel_second_kind;
+    IR3 to_covariant(const IR3& B) const { return contraction(g, B); };
+    IR3 to_contravariant(const IR3& B) const {
+      return contraction(inverse, B);
+    };
+    IR3 inertial_force(const IR3& dot_q) const;
+  };
+
   metric_covariant() {};
   virtual ~metric_covariant() {};
 
@@ -63,6 +85,25 @@ class metric_covariant {
   virtual ddIR3 christoffel_first_kind(const IR3& q) const;
   virtual ddIR3 christoffel_second_kind(const IR3& q) const;
   virtual IR3 inertial_force(const IR3& q, const IR3& dot_q) const;
+  virtual metric_bundle bundle(const IR3& q, bool christoffel = false) const;
+
+  virtual void eval_batch(const IR3span& q, std::span<SM3> out) const;
+  virtual void del_batch(const IR3span& q, std::span<dSM3> out) const;
+  virtual void jacobian_batch(const IR3span& q, std::span<double> out) const;
+  virtual void del_jacobian_batch(const IR3span& q, std::span<IR3> out) const;
+  virtual void inverse_batch(const IR3span& q, std::span<SM3> out) const;
+  virtual void del_inverse_batch(
+      const IR3span& q, std::span<dSM3> out) const;
+  virtual void christoffel_first_kind_batch(
+      const IR3span& q, std::span<ddIR3> out) const;
+  virtual void christoffel_second_kind_batch(
+      const IR3span& q, std::span<ddIR3> out) const;
+ protected:
+  static metric_bundle bundle_from(
+      const SM3& g, const dSM3& dg, double jacobian, bool christoffel);
+  static ddIR3 christoffel_from(const dSM3& dg);
+ private:
+  static IR3 inertial_force_from(const ddIR3& gamma, const IR3& dot_q);
 };
 
 inline SM3 metric_covariant::inverse(const IR3& q) const {
@@ -58,4 +58,17 @@ IR3 metric_cylindrical::inertial_force(const IR3& q, const IR3& vel) const {
       -2 * gamma[ddIR3::vuv] * vel[IR3::u] * vel[IR3::v], 0};
 }
 
+metric_covariant::metric_bundle metric_cylindrical::bundle(
+    const IR3& q, bool christoffel) const {
+  metric_bundle b = {
+      metric_cylindrical::operator()(q), metric_cylindrical::inverse(q),
+      metric_cylindrical::jacobian(q), metric_cylindrical::del(q),
+      metric_cylindrical::del_jacobian(q), {}, {}};
+  if (christoffel) {
+    b.christoffel_first_kind = metric_cylindrical::christoffel_first_kind(q);
+    b.christoffel_second_kind = metric_cylindrical::christoffel_second_kind(q);
+  }
+  return b;
+}
+
 }  // end namespace gyronimo
@@ -30,7 +30,8 @@ namespace gyronimo {
     The contravariant coordinates are the distance to the axis (normalised to
     `Lref` in SI units), the angle measured counterclockwise when seen from the
     top of the axis (in rads), and the length measured along the latter (also
-    normalised to `Lref`).
+    normalised to `Lref`). The `bundle()` is built from the closed forms of
+    the metric, its derivatives, and Christoffel symbols.
 */
 class metric_cylindrical : public metric_connected {
  public:
@@ -46,6 +47,8 @@ class metric_cylindrical : public metric_connected {
   virtual ddIR3 christoffel_first_kind(const IR3& q) const override;
   virtual ddIR3 christoffel_second_kind(const IR3& q) const override;
   virtual IR3 inertial_force(const IR3& q, const IR3& dot_q) const override;
+  virtual metric_bundle bundle(
+      const IR3& q, bool christoffel = false) const override;
 
   double Lref() { return Lref_; };
   const morphism_cylindrical* my_morphism() const {
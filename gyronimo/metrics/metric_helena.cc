@@ -62,5 +62,34 @@ dSM3 metric_helena::del(const IR3& q) const {
       squaredR0_ * (*gww_).partial_u(s, chi),
       squaredR0_ * (*gww_).partial_v(s, chi), 0};
 }
+metric_covariant::metric_bundle metric_helena::bundle(
+    const IR3& q, bool christoffel) const {
+  return metric_covariant::bundle_from(
+      (*this)(q), this->del(q), this->jacobian(q), christoffel);
+}
+void metric_helena::eval_batch(const IR3span& q, std::span<SM3> out) const {
+  check_batch_size(q, out);
+  for (size_t i = 0; i < q.size(); i++) {
+    double s = q.u()[i], chi = parser_->reduce_chi(q.v()[i]);
+    out[i] = {
+        squaredR0_ * (*guu_)(s, chi), squaredR0_ * (*guv_)(s, chi), 0,
+        squaredR0_ * (*gvv_)(s, chi), 0, squaredR0_ * (*gww_)(s, chi)};
+  }
+}
+void metric_helena::del_batch(const IR3span& q, std::span<dSM3> out) const {
+  check_batch_size(q, out);
+  for (size_t i = 0; i < q.size(); i++) {
+    double s = q.u()[i], chi = parser_->reduce_chi(q.v()[i]);
+    out[i] = {
+        squaredR0_ * (*guu_).partial_u(s, chi),
+        squaredR0_ * (*guu_).partial_v(s, chi), 0,
+        squaredR0_ * (*guv_).partial_u(s, chi),
+        squaredR0_ * (*guv_).partial_v(s, chi), 0, 0, 0, 0,
+        squaredR0_ * (*gvv_).partial_u(s, chi),
+        squaredR0_ * (*gvv_).partial_v(s, chi), 0, 0, 0, 0,
+        squaredR0_ * (*gww_).partial_u(s, chi),
+        squaredR0_ * (*gww_).partial_v(s, chi), 0};
+  }
+}
 
 }  // end namespace gyronimo
@@ -43,7 +43,10 @@ namespace gyronimo {
     computed using their `metric_covariant` implementation, which requires 1st
     order derivatives of the metric, rather than the `metric_connected` one to
     avoid resorting to the 2nd order derivatives of the `morphism_helena`
-    interpolators.
+    interpolators. The metric and its derivatives are also specialised for
+    batches of positions, evaluating the interpolators directly. For the same
+    reason, `bundle()` follows the `metric_covariant` rules (the jacobian
+    gradient thus agreeing with `del_jacobian()` to interpolation accuracy).
 */
 class metric_helena : public metric_connected {
  public:
@@ -54,6 +57,12 @@ class metric_helena : public metric_connected {
   virtual dSM3 del(const IR3& q) const override;
   virtual ddIR3 christoffel_first_kind(const IR3& q) const override;
   virtual ddIR3 christoffel_second_kind(const IR3& q) const override;
+  virtual metric_bundle bundle(
+      const IR3& q, bool christoffel = false) const override;
+  virtual void eval_batch(
+      const IR3span& q, std::span<SM3> out) const override;
+  virtual void del_batch(
+      const IR3span& q, std::span<dSM3> out) const override;
 
   const parser_helena* parser() const { return parser_; };
   const morphism_helena* my_morphism() const {
@@ -70,5 +70,11 @@ IR3 metric_polar_torus::to_contravariant(const IR3& B, const IR3& q) const {
       B[IR3::u] / minor_radius_squared_,
       B[IR3::v] / (minor_radius_squared_ * r * r), B[IR3::w] / (R * R)};
 }
+metric_covariant::metric_bundle metric_polar_torus::bundle(
+    const IR3& q, bool christoffel) const {
+  return metric_covariant::bundle_from(
+      metric_polar_torus::operator()(q), metric_polar_torus::del(q),
+      metric_polar_torus::jacobian(q), christoffel);
+}
 
 }  // end namespace gyronimo.
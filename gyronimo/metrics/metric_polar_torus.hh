@@ -33,7 +33,8 @@ namespace gyronimo {
     counterclockwise on the poloidal cross section from the low-field side
     midplane, and the toroidal angle measured clockwise when looking from the
     torus' top. The lengths `minor_radius` and `major_radius` are in SI units
-    and both angles are in rads.
+    and both angles are in rads. The `bundle()` is built from the analytical
+    metric, its derivatives, and jacobian, without virtual calls.
 */
 class metric_polar_torus : public metric_connected {
  public:
@@ -45,6 +46,8 @@ class metric_polar_torus : public metric_connected {
   virtual double jacobian(const IR3& q) const override;
   virtual IR3 to_covariant(const IR3& B, const IR3& q) const override;
   virtual IR3 to_contravariant(const IR3& B, const IR3& q) const override;
+  virtual metric_bundle bundle(
+      const IR3& q, bool christoffel = false) const override;
 
   double minor_radius() const { return minor_radius_; };
   double major_radius() const { return major_radius_; };
@@ -91,4 +91,17 @@ IR3 metric_spherical::inertial_force(const IR3& q, const IR3& dot_q) const {
       -2 * (gamma[ddIR3::wuw] * dot_qu + gamma[ddIR3::wvw] * dot_qv) * dot_qw};
 }
 
+metric_covariant::metric_bundle metric_spherical::bundle(
+    const IR3& q, bool christoffel) const {
+  metric_bundle b = {
+      metric_spherical::operator()(q), metric_spherical::inverse(q),
+      metric_spherical::jacobian(q), metric_spherical::del(q),
+      metric_spherical::del_jacobian(q), {}, {}};
+  if (christoffel) {
+    b.christoffel_first_kind = metric_spherical::christoffel_first_kind(q);
+    b.christoffel_second_kind = metric_spherical::christoffel_second_kind(q);
+  }
+  return b;
+}
+
 }  // end namespace gyronimo.
@@ -31,6 +31,8 @@ namespace gyronimo {
     `Lref` in SI units), the angle measured from the `z` axis (i.e., co-latitude
     measured from the north pole), and the angle measured from the `x` axis
     counterclockwise when seen from the north pole. Both angles are in rads.
+    The `bundle()` is built from the closed forms of the metric, its
+    derivatives, and Christoffel symbols.
 */
 class metric_spherical : public metric_connected {
  public:
@@ -46,6 +48,8 @@ class metric_spherical : public metric_connected {
   virtual ddIR3 christoffel_first_kind(const IR3& q) const override;
   virtual ddIR3 christoffel_second_kind(const IR3& q) const override;
   virtual IR3 inertial_force(const IR3& q, const IR3& dot_q) const override;
+  virtual metric_bundle bundle(
+      const IR3& q, bool christoffel = false) const override;
 
   double Lref() const { return Lref_; };
   const morphism_spherical* my_morphism() const {
@@ -17,11 +17,238 @@
 
 // @metric_vmec.cc, this file is part of ::gyronimo::
 
+#include <gyronimo/core/error.hh>
 #include <gyronimo/metrics/metric_vmec.hh>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <numeric>
+
 namespace gyronimo {
 
-metric_vmec::metric_vmec(const morphism_vmec* morph)
-    : metric_connected(morph), morphism_(morph), parser_(morph->my_parser()) {}
+metric_vmec::metric_vmec(
+    const morphism_vmec* morph, const interpolator1d_factory* ifactory,
+    bool lazy)
+    : metric_connected(morph), morphism_(morph), parser_(morph->my_parser()),
+      context_(morph->context()), harmonics_(parser_->mnmax_nyq()),
+      m_(parser_->xm_nyq()), n_(parser_->xn_nyq()), index_(harmonics_),
+      radial_jacobian_(
+          ifactory ? build_jacobian_spline(ifactory, lazy) : nullptr),
+      jacobian_mismatch_(
+          ifactory && lazy ? std::numeric_limits<double>::quiet_NaN() : 0) {
+  std::iota(index_.begin(), index_.end(), 0);
+  if (radial_jacobian_ && !lazy) {
+    jacobian_mismatch_ = this->measure_jacobian_mismatch();
+    if (jacobian_mismatch_ > 1.0e-2)
+      warning(
+          "metric_vmec: gmnc jacobian mismatch " +
+          std::to_string(jacobian_mismatch_) + ".");
+  }
+}
+
+//! Restores the `gmnc` splines (if any) saved by `save()` into `s`.
+/*!
+    The coefficients are read in place from `s`, which must outlive this
+    object. Aborts if `s` was saved from another file or its splines are not
+    on the half mesh.
+*/
+metric_vmec::metric_vmec(const morphism_vmec* morph, const snapshot* s)
+    : metric_connected(morph), morphism_(morph), parser_(morph->my_parser()),
+      context_(morph->context()), harmonics_(parser_->mnmax_nyq()),
+      m_(parser_->xm_nyq()), n_(parser_->xn_nyq()), index_(harmonics_),
+      radial_jacobian_(
+          s->contains("metric_vmec.jacobian.coefficients") ?
+              new spline1d_array(*s, "metric_vmec.jacobian") : nullptr),
+      jacobian_mismatch_((*s)["metric_vmec.mismatch"][0]) {
+  if (!std::ranges::equal(
+          (*s)["metric_vmec.fingerprint"], context_->fingerprint()))
+    error(__func__, __FILE__, __LINE__, " snapshot of another file.", 1);
+  if (radial_jacobian_ && (radial_jacobian_->size() != harmonics_ ||
+          !std::ranges::equal(
+              radial_jacobian_->grid(), parser_->sgrid_half_cell())))
+    error(__func__, __FILE__, __LINE__, " bad snapshot of jacobian.", 1);
+  std::iota(index_.begin(), index_.end(), 0);
+}
+
+//! Adds the `gmnc` splines (if any) and their mismatch to `w`.
+void metric_vmec::save(snapshot::writer& w) const {
+  w.add("metric_vmec.fingerprint", context_->fingerprint());
+  w.add("metric_vmec.mismatch", jacobian_mismatch_);
+  if (radial_jacobian_) radial_jacobian_->save(w, "metric_vmec.jacobian");
+}
+
+//! Half-mesh radial splines of all `gmnc` harmonics, sign-flipped to @f$J@f$.
+spline1d_array* metric_vmec::build_jacobian_spline(
+    const interpolator1d_factory* ifactory, bool lazy) const {
+  std::vector<size_t> modes(harmonics_);
+  std::iota(modes.begin(), modes.end(), 0);
+  return new spline1d_array(context_->radial_splines(
+      {&parser_vmec::gmnc}, modes, -1, true, ifactory, lazy));
+}
+
+//! Largest relative difference between the `gmnc` and geometric jacobians.
+/*!
+    Sampled on a few flux surfaces over one field period, away from the
+    magnetic axis (where both vanish).
+*/
+double metric_vmec::measure_jacobian_mismatch() const {
+  double mismatch = 0, period = 2 * std::numbers::pi / parser_->nfp();
+  for (double s : {0.25, 0.5, 0.75, 1.0})
+    for (size_t j = 0; j < 8; j++)
+      for (size_t k = 0; k < 4; k++) {
+        IR3 q = {s, k * period / 4, j * std::numbers::pi / 4};
+        double J = gyronimo::determinant(morphism_->geometry(q, false).del);
+        mismatch = std::max(mismatch, std::abs(this->jacobian(q) / J - 1));
+      }
+  return mismatch;
+}
+
+//! Metric @f$g_{ij}=\mathbf{e}_i\cdot\mathbf{e}_j@f$ from `geometry()`.
+SM3 metric_vmec::operator()(const IR3& q) const {
+  return metric_connected::from_tangent_basis(
+      morphism_->geometry(q, false).del);
+}
+
+//! Metric derivatives via @f$\partial_k g_{ij}=\Gamma_{ijk}+\Gamma_{jik}@f$.
+dSM3 metric_vmec::del(const IR3& q) const {
+  return metric_connected::del_from_christoffel(
+      this->christoffel_first_kind(q));
+}
+
+//! Jacobian, from `gmnc` or as the determinant of the tangent basis.
+double metric_vmec::jacobian(const IR3& q) const {
+  if (!radial_jacobian_)
+    return gyronimo::determinant(morphism_->geometry(q, false).del);
+  double s = q[IR3::u], zeta = q[IR3::v], theta = q[IR3::w];
+  context_vmec::reduced_t angles = context_->reduce(theta, zeta);
+  auto cis_mn = context_->cis_nyq(angles.theta, angles.zeta);
+  const auto& radial = (*radial_jacobian_)(s, context_->half_cell(s));
+  return std::transform_reduce(
+      index_.begin(), index_.end(), 0.0, std::plus<>(), [&](size_t i) {
+        return radial.f[i] * std::real(cis_mn[i]);
+      });
+}
+
+//! Jacobian gradient, from `gmnc` or from @f$\partial_i J = J\Gamma^j_{ij}@f$.
+IR3 metric_vmec::del_jacobian(const IR3& q) const {
+  if (!radial_jacobian_) {
+    const morphism_vmec::geometry_bundle& x = morphism_->geometry(q);
+    return gyronimo::determinant(x.del) *
+        metric_connected::contracted_christoffel(
+            gyronimo::inverse(x.del), x.ddel);
+  }
+  aux_jacobian_t a = this->jacobian_terms(q);
+  return {a.djdu, a.djdv, a.djdw};
+}
+
+//! Jacobian and its gradient from `gmnc`, in a single pass over harmonics.
+metric_vmec::aux_jacobian_t metric_vmec::jacobian_terms(const IR3& q) const {
+  double s = q[IR3::u], zeta = q[IR3::v], theta = q[IR3::w];
+  context_vmec::reduced_t angles = context_->reduce(theta, zeta);
+  auto cis_mn = context_->cis_nyq(angles.theta, angles.zeta);
+  const auto& radial = (*radial_jacobian_)(s, context_->half_cell(s));
+  return std::transform_reduce(
+      index_.begin(), index_.end(), aux_jacobian_t {0, 0, 0, 0},
+      std::plus<>(), [&](size_t i) -> aux_jacobian_t {
+        double j_mn_i = radial.f[i];
+        double cos_mn_i = std::real(cis_mn[i]);
+        double sin_mn_i = angles.parity * std::imag(cis_mn[i]);
+        return {
+            j_mn_i * cos_mn_i, radial.df[i] * cos_mn_i,
+            n_[i] * j_mn_i * sin_mn_i, -m_[i] * j_mn_i * sin_mn_i};
+      });
+}
+
+//! Christoffel @f$\Gamma_{kij}=\mathbf{e}_k\cdot\partial^2_{ij}\mathbf{x}@f$.
+ddIR3 metric_vmec::christoffel_first_kind(const IR3& q) const {
+  const morphism_vmec::geometry_bundle& x = morphism_->geometry(q);
+  return contraction<first>(x.del, x.ddel);
+}
+
+//! Christoffel @f$\Gamma^k_{ij}=\mathbf{e}^k\cdot\partial^2_{ij}\mathbf{x}@f$.
+ddIR3 metric_vmec::christoffel_second_kind(const IR3& q) const {
+  const morphism_vmec::geometry_bundle& x = morphism_->geometry(q);
+  return contraction<second>(gyronimo::inverse(x.del), x.ddel);
+}
+
+//! Metric quantities from a single `morphism_vmec::geometry()` call.
+/*!
+    The jacobian and its gradient are taken from `gmnc`, if available, as in
+    `jacobian()` and `del_jacobian()`.
+*/
+metric_covariant::metric_bundle metric_vmec::bundle(
+    const IR3& q, bool christoffel) const {
+  const morphism_vmec::geometry_bundle& x = morphism_->geometry(q);
+  metric_bundle b = metric_connected::bundle_from_tangent_basis(
+      x.del, x.ddel, christoffel);
+  if (radial_jacobian_) {
+    aux_jacobian_t a = this->jacobian_terms(q);
+    b.jacobian = a.j;
+    b.del_jacobian = {a.djdu, a.djdv, a.djdw};
+  }
+  return b;
+}
+
+//! Batched jacobian, from `gmnc` (if available) in chunks of positions.
+void metric_vmec::jacobian_batch(
+    const IR3span& q, std::span<double> out) const {
+  if (!radial_jacobian_) {
+    metric_connected::jacobian_batch(q, out);
+    return;
+  }
+  check_batch_size(q, out);
+  for (size_t first = 0; first < q.size(); first += context_vmec::chunk_size) {
+    IR3span chunk = q.subspan(first, context_vmec::chunk_size);
+    size_t n = chunk.size();
+    auto s = chunk.u();
+    auto cis = context_->cis_batch(chunk, index_, true);
+    auto cells = this->radial_cells(s);
+    std::fill_n(out.begin() + first, n, 0.0);
+    for (size_t i : index_)
+      for (size_t p = 0; p < n; p++) {
+        double j[3];
+        radial_jacobian_->evaluate(i, cells[p], s[p], j);
+        out[first + p] += j[0] * std::real(cis[i * n + p]);
+      }
+  }
+}
+
+//! Batched jacobian gradient, from `gmnc` (if available) in chunks.
+void metric_vmec::del_jacobian_batch(
+    const IR3span& q, std::span<IR3> out) const {
+  if (!radial_jacobian_) {
+    metric_connected::del_jacobian_batch(q, out);
+    return;
+  }
+  check_batch_size(q, out);
+  for (size_t first = 0; first < q.size(); first += context_vmec::chunk_size) {
+    IR3span chunk = q.subspan(first, context_vmec::chunk_size);
+    size_t n = chunk.size();
+    auto s = chunk.u();
+    auto cis = context_->cis_batch(chunk, index_, true);
+    auto cells = this->radial_cells(s);
+    std::fill_n(out.begin() + first, n, IR3 {0, 0, 0});
+    for (size_t i : index_)
+      for (size_t p = 0; p < n; p++) {
+        double cos_mn = std::real(cis[i * n + p]);
+        double sin_mn = std::imag(cis[i * n + p]);
+        double j[3];
+        radial_jacobian_->evaluate(i, cells[p], s[p], j);
+        out[first + p][IR3::u] += j[1] * cos_mn;
+        out[first + p][IR3::v] += n_[i] * j[0] * sin_mn;
+        out[first + p][IR3::w] += -m_[i] * j[0] * sin_mn;
+      }
+  }
+}
+
+//! Cells of the `gmnc` grid containing the flux values `s` of a chunk.
+std::array<size_t, context_vmec::chunk_size> metric_vmec::radial_cells(
+    std::span<const double> s) const {
+  std::array<size_t, context_vmec::chunk_size> cells;
+  for (size_t p = 0; p < s.size(); p++) cells[p] = radial_jacobian_->cell(s[p]);
+  return cells;
+}
 
 }  // end namespace gyronimo
@@ -21,27 +21,89 @@
 #define GYRONIMO_METRIC_VMEC
 
 #include <gyronimo/interpolators/interpolator1d.hh>
+#include <gyronimo/interpolators/spline1d_array.hh>
 #include <gyronimo/metrics/metric_connected.hh>
 #include <gyronimo/metrics/morphism_vmec.hh>
 
+#include <array>
+#include <memory>
+
 namespace gyronimo {
 
 //! Covariant metric corresponding to a `morphism_vmec` object.
 /*
     This class inherits all functionality from its `metric_connected` parent,
-    which is extracted from the `morphism_vmec` it is connected to.
+    which is extracted from the `morphism_vmec` it is connected to. The metric,
+    its derivatives, the jacobian and its gradient, the Christoffel symbols,
+    and `bundle()` are specialised to get the morphism first and second
+    derivatives from `morphism_vmec::geometry()`, i.e., from a single pass over
+    the `VMEC` harmonics that is shared by all these members at the same point.
+    The metric and the jacobian only request the first derivatives, thus
+    sparing the second-derivative sums if nothing else is needed there.
+    If an `interpolator1d_factory` is supplied, the jacobian and its gradient
+    are instead evaluated from the `gmnc` series (i.e., @f$J = -\sqrt{g}@f$,
+    the sign accounting for the swapped order of `VMEC` angles), interpolated
+    on the half mesh `sgrid_half_cell` where `VMEC` stores it, with no call
+    to the morphism, in `jacobian_batch()`, `del_jacobian_batch()`, and
+    `bundle()` as well. The largest relative mismatch between both values, found
+    at construction on a sample of points, is returned by
+    `jacobian_mismatch()` and a warning is issued if it exceeds one percent.
+    In `lazy` mode, the `gmnc` interpolators are only built on first use (and
+    `ifactory` must remain valid until then), the check being skipped (i.e.,
+    `jacobian_mismatch()` returns NaN). The `gmnc` splines, if any, may be
+    saved to a `snapshot` and restored from it by other runs.
 */
 class metric_vmec : public metric_connected {
  public:
-  metric_vmec(const morphism_vmec* morph);
+  using narray_type = parser_vmec::narray_type;
+  metric_vmec(
+      const morphism_vmec* morph,
+      const interpolator1d_factory* ifactory = nullptr, bool lazy = false);
+  metric_vmec(const morphism_vmec* morph, const snapshot* s);
   virtual ~metric_vmec() override {};
+  virtual SM3 operator()(const IR3& q) const override;
+  virtual dSM3 del(const IR3& q) const override;
+  virtual double jacobian(const IR3& q) const override;
+  virtual IR3 del_jacobian(const IR3& q) const override;
+  virtual ddIR3 christoffel_first_kind(const IR3& q) const override;
+  virtual ddIR3 christoffel_second_kind(const IR3& q) const override;
+  virtual metric_bundle bundle(
+      const IR3& q, bool christoffel = false) const override;
+  virtual void jacobian_batch(
+      const IR3span& q, std::span<double> out) const override;
+  virtual void del_jacobian_batch(
+      const IR3span& q, std::span<IR3> out) const override;
   const parser_vmec* my_parser() const { return parser_; };
   const morphism_vmec* my_morphism() const { return morphism_; };
+  double jacobian_mismatch() const { return jacobian_mismatch_; };
+  void save(snapshot::writer& w) const;
  private:
   const morphism_vmec* morphism_;
   const parser_vmec* parser_;
+  const context_vmec* context_;
+  const size_t harmonics_;
+  const narray_type m_, n_;
+  std::vector<size_t> index_;
+  std::unique_ptr<const spline1d_array> radial_jacobian_;
+  double jacobian_mismatch_;
+
+  spline1d_array* build_jacobian_spline(
+      const interpolator1d_factory* ifactory, bool lazy) const;
+  double measure_jacobian_mismatch() const;
+  struct aux_jacobian_t { double j, djdu, djdv, djdw; };
+  aux_jacobian_t jacobian_terms(const IR3& q) const;
+  std::array<size_t, context_vmec::chunk_size> radial_cells(
+      std::span<const double> s) const;
+  friend aux_jacobian_t operator+(
+      const aux_jacobian_t& x, const aux_jacobian_t& y);
 };
 
+inline metric_vmec::aux_jacobian_t operator+(
+    const metric_vmec::aux_jacobian_t& x,
+    const metric_vmec::aux_jacobian_t& y) {
+  return {x.j + y.j, x.djdu + y.djdu, x.djdv + y.djdv, x.djdw + y.djdw};
+}
+
 }  // end namespace gyronimo
 
 #endif  // GYRONIMO_METRIC_VMEC
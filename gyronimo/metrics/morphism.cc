@@ -23,10 +23,30 @@ namespace gyronimo {
 
 //! Jacobian @f$ \mathbf{e}_u \cdot (\mathbf{e}_v \times \mathbf{e}_w) @f$.
 double morphism::jacobian(const IR3& q) const {
-  dIR3 e = del(q);
-  return e[dIR3::uu] * (e[dIR3::vv] * e[dIR3::ww] - e[dIR3::vw] * e[dIR3::wv]) +
-      e[dIR3::uv] * (e[dIR3::vw] * e[dIR3::wu] - e[dIR3::vu] * e[dIR3::ww]) +
-      e[dIR3::uw] * (e[dIR3::vu] * e[dIR3::wv] - e[dIR3::vv] * e[dIR3::wu]);
+  return gyronimo::determinant(del(q));
+}
+
+void morphism::eval_batch(const IR3span& q, std::span<IR3> out) const {
+  check_batch_size(q, out);
+  for (size_t i = 0; i < q.size(); i++) out[i] = (*this)(q[i]);
+}
+void morphism::del_batch(const IR3span& q, std::span<dIR3> out) const {
+  check_batch_size(q, out);
+  for (size_t i = 0; i < q.size(); i++) out[i] = this->del(q[i]);
+}
+void morphism::ddel_batch(const IR3span& q, std::span<ddIR3> out) const {
+  check_batch_size(q, out);
+  for (size_t i = 0; i < q.size(); i++) out[i] = this->ddel(q[i]);
+}
+void morphism::jacobian_batch(
+    const IR3span& q, std::span<double> out) const {
+  check_batch_size(q, out);
+  for (size_t i = 0; i < q.size(); i++) out[i] = this->jacobian(q[i]);
+}
+void morphism::del_inverse_batch(
+    const IR3span& q, std::span<dIR3> out) const {
+  check_batch_size(q, out);
+  for (size_t i = 0; i < q.size(); i++) out[i] = this->del_inverse(q[i]);
 }
 
 }  // end namespace gyronimo
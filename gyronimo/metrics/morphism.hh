@@ -21,6 +21,7 @@
 #define GYRONIMO_MORPHISM
 
 #include <gyronimo/core/IR3algebra.hh>
+#include <gyronimo/core/IR3span.hh>
 #include <gyronimo/core/contraction.hh>
 
 namespace gyronimo {
@@ -34,7 +35,9 @@ namespace gyronimo {
     inverse derivative and the transformation jacobian, dual and tangent-space
     basis, and conversion between covariant and contravariant components. These
     methods are left virtual to allow more efficient reimplementations in
-    derived classes, if needed.
+    derived classes, if needed. The same holds for the batched counterparts
+    (e.g., `del_batch`, with `eval_batch` standing for `operator()`), which
+    evaluate a whole `IR3span` of positions into caller-owned buffers.
 */
 class morphism {
  public:
@@ -55,6 +58,13 @@ class morphism {
   virtual IR3 translation(const IR3& q, const IR3& delta) const;
   virtual std::array<IR3, 3> tan_basis(const IR3& q) const;
   virtual std::array<IR3, 3> dual_basis(const IR3& q) const;
+
+  virtual void eval_batch(const IR3span& q, std::span<IR3> out) const;
+  virtual void del_batch(const IR3span& q, std::span<dIR3> out) const;
+  virtual void ddel_batch(const IR3span& q, std::span<ddIR3> out) const;
+  virtual void jacobian_batch(const IR3span& q, std::span<double> out) const;
+  virtual void del_inverse_batch(
+      const IR3span& q, std::span<dIR3> out) const;
  private:
   std::array<IR3, 3> export_basis_set(const dIR3& d) const;
 };
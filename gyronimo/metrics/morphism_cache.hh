@@ -20,19 +20,29 @@
 #ifndef GYRONIMO_MORPHISM_CACHE
 #define GYRONIMO_MORPHISM_CACHE
 
+#include <gyronimo/core/multislot_cache.hh>
+#include <gyronimo/core/per_thread.hh>
 #include <gyronimo/metrics/morphism.hh>
 
 namespace gyronimo {
 
 //! Cache layer over objects derived from `morphism`.
 /*!
-    Defines a depth-1 cache layer (or a decorator) for all member functions
+    Defines a depth-`N` cache layer (or a decorator) for all member functions
     declared in the `morphism` interface. Because it derives from its template
     argument, it can be used to replace pointers or references to objects of
     that type in client code. The cache object is constructed with the same
     constructor call as its template argument.
+
+    Each instance keeps its own cache in each thread (see `per_thread`), so
+    concurrent readers are safe and distinct instances of the same type never
+    evict each other's entries. Every member function remembers its `N` most
+    recent evaluations (see `multislot_cache`), the default being enough for
+    the four stages of a Runge-Kutta step, with the observer's sample point
+    hitting the first stage of the next step.
 */
-template<typename T> requires std::derived_from<T, morphism>
+template<typename T, size_t N = 4>
+  requires std::derived_from<T, morphism>
 class morphism_cache : public T {
  public:
   template<typename... Args> morphism_cache(Args... args) : T(args...) {};
@@ -51,116 +61,101 @@ class morphism_cache : public T {
   virtual std::array<IR3, 3> tan_basis(const IR3& q) const override;
   virtual std::array<IR3, 3> dual_basis(const IR3& q) const override;
  private:
-  static inline IR3 un_init_ = {123456789., 987654321., 192837465.};
+  struct slots_t {
+    multislot_cache<N, IR3, IR3> eval;
+    multislot_cache<N, IR3, IR3> inverse;
+    multislot_cache<N, dIR3, IR3> del;
+    multislot_cache<N, ddIR3, IR3> ddel;
+    multislot_cache<N, double, IR3> jacobian;
+    multislot_cache<N, dIR3, IR3> del_inverse;
+    multislot_cache<N, IR3, IR3, IR3> to_covariant;
+    multislot_cache<N, IR3, IR3, IR3> to_contravariant;
+    multislot_cache<N, IR3, IR3, IR3> from_covariant;
+    multislot_cache<N, IR3, IR3, IR3> from_contravariant;
+    multislot_cache<N, IR3, IR3, IR3> translation;
+    multislot_cache<N, std::array<IR3, 3>, IR3> tan_basis;
+    multislot_cache<N, std::array<IR3, 3>, IR3> dual_basis;
+  };
+  per_thread<slots_t> slots_;
 };
 
-template<typename T> requires std::derived_from<T, morphism>
-IR3 morphism_cache<T>::operator()(const IR3& q) const {
-  thread_local IR3 cache_q = un_init_, cache_eval = {0, 0, 0};
-  if (q == cache_q) return cache_eval;
-  cache_q = q;
-  return cache_eval = T::operator()(q);
+template<typename T, size_t N> requires std::derived_from<T, morphism>
+IR3 morphism_cache<T, N>::operator()(const IR3& q) const {
+  auto& cache = slots_.local().eval;
+  if (auto hit = cache.find(q)) return *hit;
+  return cache.insert(T::operator()(q), q);
 }
-template<typename T> requires std::derived_from<T, morphism>
-IR3 morphism_cache<T>::inverse(const IR3& x) const {
-  thread_local IR3 cache_x = un_init_, cache_eval = {0, 0, 0};
-  if (x == cache_x) return cache_eval;
-  cache_x = x;
-  return cache_eval = T::inverse(x);
+template<typename T, size_t N> requires std::derived_from<T, morphism>
+IR3 morphism_cache<T, N>::inverse(const IR3& x) const {
+  auto& cache = slots_.local().inverse;
+  if (auto hit = cache.find(x)) return *hit;
+  return cache.insert(T::inverse(x), x);
 }
-template<typename T> requires std::derived_from<T, morphism>
-dIR3 morphism_cache<T>::del(const IR3& q) const {
-  thread_local IR3 cache_q = un_init_;
-  thread_local dIR3 cache_eval = {0, 0, 0, 0, 0, 0, 0, 0, 0};
-  if (q == cache_q) return cache_eval;
-  cache_q = q;
-  return cache_eval = T::del(q);
+template<typename T, size_t N> requires std::derived_from<T, morphism>
+dIR3 morphism_cache<T, N>::del(const IR3& q) const {
+  auto& cache = slots_.local().del;
+  if (auto hit = cache.find(q)) return *hit;
+  return cache.insert(T::del(q), q);
 }
-template<typename T> requires std::derived_from<T, morphism>
-ddIR3 morphism_cache<T>::ddel(const IR3& q) const {
-  thread_local IR3 cache_q = un_init_;
-  thread_local ddIR3 cache_eval = {
-      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-  if (q == cache_q) return cache_eval;
-  cache_q = q;
-  return cache_eval = T::ddel(q);
+template<typename T, size_t N> requires std::derived_from<T, morphism>
+ddIR3 morphism_cache<T, N>::ddel(const IR3& q) const {
+  auto& cache = slots_.local().ddel;
+  if (auto hit = cache.find(q)) return *hit;
+  return cache.insert(T::ddel(q), q);
 }
-template<typename T> requires std::derived_from<T, morphism>
-double morphism_cache<T>::jacobian(const IR3& q) const {
-  thread_local IR3 cache_q = un_init_;
-  thread_local double cache_eval = 0;
-  if (q == cache_q) return cache_eval;
-  cache_q = q;
-  return cache_eval = T::jacobian(q);
+template<typename T, size_t N> requires std::derived_from<T, morphism>
+double morphism_cache<T, N>::jacobian(const IR3& q) const {
+  auto& cache = slots_.local().jacobian;
+  if (auto hit = cache.find(q)) return *hit;
+  return cache.insert(T::jacobian(q), q);
 }
-template<typename T> requires std::derived_from<T, morphism>
-dIR3 morphism_cache<T>::del_inverse(const IR3& q) const {
-  thread_local IR3 cache_q = un_init_;
-  thread_local dIR3 cache_eval = {0, 0, 0, 0, 0, 0, 0, 0, 0};
-  if (q == cache_q) return cache_eval;
-  cache_q = q;
-  return cache_eval = T::del_inverse(q);
+template<typename T, size_t N> requires std::derived_from<T, morphism>
+dIR3 morphism_cache<T, N>::del_inverse(const IR3& q) const {
+  auto& cache = slots_.local().del_inverse;
+  if (auto hit = cache.find(q)) return *hit;
+  return cache.insert(T::del_inverse(q), q);
 }
-template<typename T> requires std::derived_from<T, morphism>
-std::array<IR3, 3> morphism_cache<T>::tan_basis(const IR3& q) const {
-  thread_local IR3 cache_q = un_init_;
-  thread_local std::array<IR3, 3> cache_eval = {un_init_, un_init_, un_init_};
-  if (q == cache_q) return cache_eval;
-  cache_q = q;
-  return cache_eval = T::tan_basis(q);
+template<typename T, size_t N> requires std::derived_from<T, morphism>
+IR3 morphism_cache<T, N>::to_covariant(const IR3& A, const IR3& q) const {
+  auto& cache = slots_.local().to_covariant;
+  if (auto hit = cache.find(A, q)) return *hit;
+  return cache.insert(T::to_covariant(A, q), A, q);
 }
-template<typename T> requires std::derived_from<T, morphism>
-std::array<IR3, 3> morphism_cache<T>::dual_basis(const IR3& q) const {
-  thread_local IR3 cache_q = un_init_;
-  thread_local std::array<IR3, 3> cache_eval = {un_init_, un_init_, un_init_};
-  if (q == cache_q) return cache_eval;
-  cache_q = q;
-  return cache_eval = T::dual_basis(q);
+template<typename T, size_t N> requires std::derived_from<T, morphism>
+IR3 morphism_cache<T, N>::to_contravariant(const IR3& A, const IR3& q) const {
+  auto& cache = slots_.local().to_contravariant;
+  if (auto hit = cache.find(A, q)) return *hit;
+  return cache.insert(T::to_contravariant(A, q), A, q);
 }
-template<typename T> requires std::derived_from<T, morphism>
-IR3 morphism_cache<T>::to_covariant(const IR3& A, const IR3& q) const {
-  thread_local IR3 cache_q = un_init_, cache_A = un_init_;
-  thread_local IR3 cache_eval = {0, 0, 0};
-  if (q == cache_q && A == cache_A) return cache_eval;
-  cache_q = q;
-  cache_A = A;
-  return cache_eval = T::to_covariant(A, q);
+template<typename T, size_t N> requires std::derived_from<T, morphism>
+IR3 morphism_cache<T, N>::from_covariant(const IR3& A, const IR3& q) const {
+  auto& cache = slots_.local().from_covariant;
+  if (auto hit = cache.find(A, q)) return *hit;
+  return cache.insert(T::from_covariant(A, q), A, q);
 }
-template<typename T> requires std::derived_from<T, morphism>
-IR3 morphism_cache<T>::to_contravariant(const IR3& A, const IR3& q) const {
-  thread_local IR3 cache_q = un_init_, cache_A = un_init_;
-  thread_local IR3 cache_eval = {0, 0, 0};
-  if (q == cache_q && A == cache_A) return cache_eval;
-  cache_q = q;
-  cache_A = A;
-  return cache_eval = T::to_contravariant(A, q);
+template<typename T, size_t N> requires std::derived_from<T, morphism>
+IR3 morphism_cache<T, N>::from_contravariant(const IR3& A, const IR3& q) const {
+  auto& cache = slots_.local().from_contravariant;
+  if (auto hit = cache.find(A, q)) return *hit;
+  return cache.insert(T::from_contravariant(A, q), A, q);
 }
-template<typename T> requires std::derived_from<T, morphism>
-IR3 morphism_cache<T>::from_covariant(const IR3& A, const IR3& q) const {
-  thread_local IR3 cache_q = un_init_, cache_A = un_init_;
-  thread_local IR3 cache_eval = {0, 0, 0};
-  if (q == cache_q && A == cache_A) return cache_eval;
-  cache_q = q;
-  cache_A = A;
-  return cache_eval = T::from_covariant(A, q);
+template<typename T, size_t N> requires std::derived_from<T, morphism>
+IR3 morphism_cache<T, N>::translation(const IR3& q, const IR3& delta) const {
+  auto& cache = slots_.local().translation;
+  if (auto hit = cache.find(q, delta)) return *hit;
+  return cache.insert(T::translation(q, delta), q, delta);
 }
-template<typename T> requires std::derived_from<T, morphism>
-IR3 morphism_cache<T>::from_contravariant(const IR3& A, const IR3& q) const {
-  thread_local IR3 cache_q = un_init_, cache_A = un_init_;
-  thread_local IR3 cache_eval = {0, 0, 0};
-  if (q == cache_q && A == cache_A) return cache_eval;
-  cache_q = q;
-  cache_A = A;
-  return cache_eval = T::from_contravariant(A, q);
+template<typename T, size_t N> requires std::derived_from<T, morphism>
+std::array<IR3, 3> morphism_cache<T, N>::tan_basis(const IR3& q) const {
+  auto& cache = slots_.local().tan_basis;
+  if (auto hit = cache.find(q)) return *hit;
+  return cache.insert(T::tan_basis(q), q);
 }
-template<typename T> requires std::derived_from<T, morphism>
-IR3 morphism_cache<T>::translation(const IR3& q, const IR3& delta) const {
-  thread_local IR3 cache_q = un_init_, cache_delta = un_init_;
-  thread_local IR3 cache_eval = {0, 0, 0};
-  if (q == cache_q && delta == cache_delta) return cache_eval;
-  cache_q = q;
-  cache_delta = delta;
-  return cache_eval = T::translation(q, delta);
+template<typename T, size_t N> requires std::derived_from<T, morphism>
+std::array<IR3, 3> morphism_cache<T, N>::dual_basis(const IR3& q) const {
+  auto& cache = slots_.local().dual_basis;
+  if (auto hit = cache.find(q)) return *hit;
+  return cache.insert(T::dual_basis(q), q);
 }
 
 }  // namespace gyronimo
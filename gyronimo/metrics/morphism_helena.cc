@@ -107,6 +107,29 @@ double morphism_helena::jacobian(const IR3& q) const {
   double Zu = z_->partial_u(s, chi), Zv = z_->partial_v(s, chi);
   return R * (Ru * Zv - Rv * Zu);
 }
+void morphism_helena::del_batch(
+    const IR3span& q, std::span<dIR3> out) const {
+  check_batch_size(q, out);
+  for (size_t i = 0; i < q.size(); i++) {
+    double s = q.u()[i], chi = parser_->reduce_chi(q.v()[i]), phi = q.w()[i];
+    double R = (*R_)(s, chi);
+    double Ru = R_->partial_u(s, chi), Rv = R_->partial_v(s, chi);
+    double cos = std::cos(phi), sin = std::sin(phi);
+    out[i] = {Ru * cos, Rv * cos, -R * sin, -Ru * sin, -Rv * sin,
+        -R * cos, z_->partial_u(s, chi), z_->partial_v(s, chi), 0.0};
+  }
+}
+void morphism_helena::jacobian_batch(
+    const IR3span& q, std::span<double> out) const {
+  check_batch_size(q, out);
+  for (size_t i = 0; i < q.size(); i++) {
+    double s = q.u()[i], chi = parser_->reduce_chi(q.v()[i]);
+    double R = (*R_)(s, chi);
+    double Ru = R_->partial_u(s, chi), Rv = R_->partial_v(s, chi);
+    double Zu = z_->partial_u(s, chi), Zv = z_->partial_v(s, chi);
+    out[i] = R * (Ru * Zv - Rv * Zu);
+  }
+}
 std::pair<double, double> morphism_helena::reflection_past_axis(
     double s, double chi) const {
   if (s < 0) return {-s, parser_->reduce_chi(chi + std::numbers::pi)};
@@ -39,6 +39,8 @@ namespace gyronimo {
     The morphism is built from the information provided by a `parser_helena`
     object. The actual type of 2d interpolators to use is set by the specific
     `interpolator2d_factory` object pointer provided to the constructor.
+    Batched derivatives and jacobians evaluate the interpolators directly,
+    with a single virtual call per batch.
 */
 class morphism_helena : public morphism {
  public:
@@ -52,6 +54,10 @@ class morphism_helena : public morphism {
 
   virtual double jacobian(const IR3& q) const override;
   virtual IR3 translation(const IR3& q, const IR3& delta) const override;
+  virtual void del_batch(
+      const IR3span& q, std::span<dIR3> out) const override;
+  virtual void jacobian_batch(
+      const IR3span& q, std::span<double> out) const override;
   const parser_helena* parser() const { return parser_; };
  private:
   const parser_helena* parser_;
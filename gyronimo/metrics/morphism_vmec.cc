@@ -20,74 +20,176 @@
 #include <gyronimo/core/multiroot.hh>
 #include <gyronimo/metrics/morphism_vmec.hh>
 
+#include <cmath>
 #include <numeric>
 
 namespace gyronimo {
 
-//! Cached evaluation of trigonometric coefficients for internal Fourier series.
-const morphism_vmec::cis_container_t& morphism_vmec::cached_cis(
-    double theta, double zeta) const {
-  thread_local double cached_theta = -1e6, cached_zeta = -1e6;
-  thread_local cis_container_t cis_mn(harmonics_);
-  if (theta != cached_theta || zeta != cached_zeta) {
-    std::transform(
-        index_.begin(), index_.end(), cis_mn.begin(),
-        [&](size_t i) -> cis_container_t::value_type {
-          double angle_mn = m_[i] * theta - n_[i] * zeta;
-          return {std::cos(angle_mn), std::sin(angle_mn)};
-        });
-    cached_theta = theta;
-    cached_zeta = zeta;
-  }
-  return cis_mn;
+//! Builds the morphism from `p`, optionally truncating small harmonics.
+/*!
+    Harmonics whose largest @f$|R_{mn}(s)|@f$ and @f$|Z_{mn}(s)|@f$ over the
+    radial grid are below `tolerance` (in `VMEC` length units, i.e., m) are
+    dropped. The sum of their amplitudes, returned by `truncation_error()`,
+    bounds the resulting error in `R` and `Z` at the radial grid points (but
+    not in their derivatives, which scale with the mode numbers). The default
+    null tolerance keeps all harmonics. If `symmetry` is set, the scalar
+    evaluations reduce the angles to the fundamental domain of the
+    stellarator-symmetric equilibrium (see `context_vmec::reduce()`), aborting
+    if `p` is not stellarator symmetric. The radial interpolators are built in
+    parallel, at construction or, if `lazy` is set, on first use (`ifactory`
+    having to remain valid until then).
+*/
+morphism_vmec::morphism_vmec(
+    const parser_vmec* p, const interpolator1d_factory* ifactory,
+    double tolerance, bool symmetry, bool lazy)
+    : parser_(p), context_(p, symmetry),
+      truncation_(context_.retained_modes(
+          {&parser_vmec::rmnc, &parser_vmec::zmns}, p->mnmax(), 1,
+          tolerance)),
+      harmonics_(truncation_.first.size()),
+      m_(this->retained(p->xm())), n_(this->retained(p->xn())),
+      index_(harmonics_), radial_(context_.radial_splines(
+          {&parser_vmec::rmnc, &parser_vmec::zmns}, truncation_.first, 1, false,
+          ifactory, lazy)) {
+  std::iota(index_.begin(), index_.end(), 0);
 }
 
+//! Restores the morphism saved by `save()` into `s`, with no recomputation.
+/*!
+    Only the scalars and mode numbers of `p` are read (i.e., `p` may be built
+    in lazy mode), the spline coefficients being read in place from `s`, which
+    must outlive this object. Aborts if `s` was saved from another file.
+*/
 morphism_vmec::morphism_vmec(
-    const parser_vmec* p, const interpolator1d_factory* ifactory)
-    : parser_(p), harmonics_(p->mnmax()), m_(p->xm()), n_(p->xn()),
-      index_(harmonics_), r_mn_(p->mnmax()), z_mn_(p->mnmax()) {
+    const parser_vmec* p, const snapshot* s, bool symmetry)
+    : parser_(p), context_(p, symmetry),
+      truncation_(context_.restore_truncation(*s, "morphism_vmec", p->mnmax())),
+      harmonics_(truncation_.first.size()),
+      m_(this->retained(p->xm())), n_(this->retained(p->xn())),
+      index_(harmonics_), radial_(*s, "morphism_vmec.radial") {
+  if (radial_.size() != 2 * harmonics_)
+    error(__func__, __FILE__, __LINE__, " bad snapshot of radial.", 1);
   std::iota(index_.begin(), index_.end(), 0);
-  this->build_interpolator_array(r_mn_, parser_->rmnc(), ifactory);
-  this->build_interpolator_array(z_mn_, parser_->zmns(), ifactory);
-}
-
-void morphism_vmec::build_interpolator_array(
-    std::vector<std::unique_ptr<interpolator1d>>& interpolator_array,
-    const narray_type& samples_array, const interpolator1d_factory* ifactory) {
-  dblock_adapter sgrid(parser_->sgrid());
-  std::transform(
-      index_.begin(), index_.end(), interpolator_array.begin(), [&](size_t i) {
-        std::slice mask_i(i, sgrid.size(), harmonics_);
-        narray_type data = samples_array[mask_i];
-        return std::move(std::unique_ptr<interpolator1d>(
-            ifactory->interpolate_data(sgrid, dblock_adapter(data))));
-      });
 }
 
+//! Adds the retained harmonics and spline coefficients to `w`.
+void morphism_vmec::save(snapshot::writer& w) const {
+  context_.save_truncation(w, "morphism_vmec", truncation_);
+  radial_.save(w, "morphism_vmec.radial");
+}
+
+//! Entries of the `VMEC` array `x` (e.g., `xm`) at the retained harmonics.
+morphism_vmec::narray_type morphism_vmec::retained(const narray_type& x) const {
+  const std::vector<size_t>& modes = truncation_.first;
+  return x[std::valarray<size_t>(modes.data(), modes.size())];
+}
+
+//! Radial coefficients of the `i`-th harmonic at the memoised `radial_` point.
+morphism_vmec::aux_radial_t morphism_vmec::radial_term(
+    size_t i, const spline1d_array::values_t& v) const {
+  size_t j = i + harmonics_;
+  return {v.f[i], v.df[i], v.d2f[i], v.f[j], v.df[j], v.d2f[j]};
+}
+
+//! Radial coefficients of the `i`-th harmonic at `s`, in the radial `cell`.
+morphism_vmec::aux_radial_t morphism_vmec::radial_term(
+    size_t i, size_t cell, double s) const {
+  double r[3], z[3];
+  radial_.evaluate(i, cell, s, r);
+  radial_.evaluate(i + harmonics_, cell, s, z);
+  return {r[0], r[1], r[2], z[0], z[1], z[2]};
+}
+
+//! Inverse, warm-started from the calling thread's last solution.
+/*!
+    If there is no previous solution, or if Newton iterations fail from it,
+    restarts from mid radius on the ray leaving the magnetic axis towards `X`.
+*/
 IR3 morphism_vmec::inverse(const IR3& X) const {
   double x = X[IR3::u], y = X[IR3::v], z = X[IR3::w];
   double r = std::sqrt(x * x + y * y), zeta = std::atan2(y, x);
+  inverse_hint_t& hint = inverse_hint_.local();
+  if (!std::isnan(hint.s))
+    if (auto root = this->newton_inverse(r, z, zeta, {hint.s, hint.theta})) {
+      hint = {root->first, root->second};
+      return {root->first, zeta, root->second};
+    }
   auto [r_axis, z_axis] = get_rz({0, zeta, 0});
   return this->inverse(X, {0.5, std::atan2(z - z_axis, r - r_axis)});
 }
 
 std::pair<double, double> morphism_vmec::get_rz(const IR3& q) const {
   double flux = q[IR3::u], zeta = q[IR3::v], theta = q[IR3::w];
-  const auto& cis_mn = morphism_vmec::cached_cis(theta, zeta);
+  context_vmec::reduced_t angles = context_.reduce(theta, zeta);
+  auto cis_mn = context_.cis(angles.theta, angles.zeta);
+  const auto& radial = radial_(flux, context_.cell(flux));
   auto [r, z] = std::transform_reduce(
       index_.begin(), index_.end(), aux_rz_t {0, 0}, std::plus<>(),
       [&](size_t i) -> aux_rz_t {
-        double r_mn_i = (*r_mn_[i])(flux), z_mn_i = (*z_mn_[i])(flux);
-        double cos_mn_i = std::real(cis_mn[i]), sin_mn_i = std::imag(cis_mn[i]);
+        double r_mn_i = radial.f[i], z_mn_i = radial.f[i + harmonics_];
+        std::complex<double> cis_mn_i = cis_mn[truncation_.first[i]];
+        double cos_mn_i = std::real(cis_mn_i);
+        double sin_mn_i = angles.parity * std::imag(cis_mn_i);
         return {r_mn_i * cos_mn_i, z_mn_i * sin_mn_i};
       });
   return {r, z};
 }
 
+//! Inverse from a `guess` for @f$(s,\theta)@f$, also kept as the next hint.
 IR3 morphism_vmec::inverse(
     const IR3& X, const std::pair<double, double>& guess) const {
   double x = X[IR3::u], y = X[IR3::v], z = X[IR3::w];
   double r = std::sqrt(x * x + y * y), zeta = std::atan2(y, x);
+  auto root = this->newton_inverse(r, z, zeta, guess);
+  if (!root) {
+    inverse_stats_.local().fallbacks++;
+    root = this->multiroot_inverse(r, z, zeta, guess);
+  }
+  inverse_hint_.local() = {root->first, root->second};
+  return {root->first, zeta, root->second};
+}
+
+//! Newton iterations on @f$(\rho,\theta)@f$, with @f$\rho=\sqrt{s}@f$.
+/*!
+    Solves @f$R(\rho^2,\zeta,\theta)=r@f$ and @f$Z(\rho^2,\zeta,\theta)=z@f$
+    using the analytic derivatives of both series. Iterating on @f$\rho@f$
+    keeps the jacobian regular close to the magnetic axis, which is crossed
+    by reflection (i.e., @f$(-\rho,\theta) \rightarrow (\rho,\theta+\pi)@f$).
+    Returns the root @f$(s,\theta)@f$ once the summed absolute residuals drop
+    below @f$10^{-12}@f$ m, or nothing if that fails to happen.
+*/
+std::optional<std::pair<double, double>> morphism_vmec::newton_inverse(
+    double r, double z, double zeta,
+    const std::pair<double, double>& guess) const {
+  constexpr size_t max_iterations = 32;
+  constexpr double tolerance = 1.0e-12;
+  inverse_stats& stats = inverse_stats_.local();
+  stats.solves++;
+  double rho = std::sqrt(std::abs(guess.first)), theta = guess.second;
+  for (size_t iteration = 0; iteration < max_iterations; iteration++) {
+    aux_inverse_t a = this->inverse_terms(rho * rho, zeta, theta);
+    double delta_r = a.r - r, delta_z = a.z - z;
+    if (std::abs(delta_r) + std::abs(delta_z) < tolerance)
+      return std::pair<double, double> {rho * rho, theta};
+    stats.iterations++;
+    double drdrho = 2 * rho * a.drdu, dzdrho = 2 * rho * a.dzdu;
+    double determinant = drdrho * a.dzdw - a.drdw * dzdrho;
+    if (!std::isfinite(determinant) || determinant == 0) break;
+    rho -= (a.dzdw * delta_r - a.drdw * delta_z) / determinant;
+    theta -= (drdrho * delta_z - dzdrho * delta_r) / determinant;
+    if (rho < 0) {
+      rho = -rho;
+      theta += std::numbers::pi;
+    }
+  }
+  stats.failures++;
+  return std::nullopt;
+}
+
+//! Root-finding with a GSL hybrid solver (finite-difference jacobian).
+std::pair<double, double> morphism_vmec::multiroot_inverse(
+    double r, double z, double zeta,
+    const std::pair<double, double>& guess) const {
   multiroot root_finder(gsl_multiroot_fsolver_hybrids, 1.0e-12, 75);
   using IR2 = std::array<double, 2>;
   std::function<IR2(const IR2&)> zero_function = [&](const IR2& args) -> IR2 {
@@ -96,71 +198,269 @@ IR3 morphism_vmec::inverse(
     return {r_trial - r, z_trial - z};
   };
   auto roots = root_finder(zero_function, IR2 {guess.first, guess.second});
-  auto [flux, theta] = reflection_past_axis(roots[0], roots[1]);
-  return {flux, zeta, theta};
+  return reflection_past_axis(roots[0], roots[1]);
+}
+
+//! @f$R@f$, @f$Z@f$, and their derivatives in @f$s@f$ and @f$\theta@f$.
+morphism_vmec::aux_inverse_t morphism_vmec::inverse_terms(
+    double flux, double zeta, double theta) const {
+  context_vmec::reduced_t angles = context_.reduce(theta, zeta);
+  auto cis_mn = context_.cis(angles.theta, angles.zeta);
+  const auto& radial = radial_(flux, context_.cell(flux));
+  return std::transform_reduce(
+      index_.begin(), index_.end(), aux_inverse_t {0, 0, 0, 0, 0, 0},
+      std::plus<>(), [&](size_t i) -> aux_inverse_t {
+        double r_mn_i = radial.f[i], z_mn_i = radial.f[i + harmonics_];
+        std::complex<double> cis_mn_i = cis_mn[truncation_.first[i]];
+        double cos_mn_i = std::real(cis_mn_i);
+        double sin_mn_i = angles.parity * std::imag(cis_mn_i);
+        return {
+            r_mn_i * cos_mn_i, z_mn_i * sin_mn_i,
+            radial.df[i] * cos_mn_i, -m_[i] * r_mn_i * sin_mn_i,
+            radial.df[i + harmonics_] * sin_mn_i, m_[i] * z_mn_i * cos_mn_i};
+      });
 }
 
 dIR3 morphism_vmec::del(const IR3& q) const {
   double s = q[IR3::u], zeta = q[IR3::v], theta = q[IR3::w];
-  const auto& cis_mn = morphism_vmec::cached_cis(theta, zeta);
+  context_vmec::reduced_t angles = context_.reduce(theta, zeta);
+  auto cis_mn = context_.cis(angles.theta, angles.zeta);
+  const auto& radial = radial_(s, context_.cell(s));
   auto a = std::transform_reduce(
-      index_.begin(), index_.end(), aux_del_t {0, 0, 0, 0, 0, 0, 0},
+      index_.begin(), index_.end(), aux_del_t {0, 0, 0, 0, 0, 0, 0, 0},
       std::plus<>(), [&](size_t i) -> aux_del_t {
-        double r_mn_i = (*r_mn_[i])(s), z_mn_i = (*z_mn_[i])(s);
-        double cos_mn_i = std::real(cis_mn[i]), sin_mn_i = std::imag(cis_mn[i]);
-        return {
-            r_mn_i * cos_mn_i,  // r_mn_i
-            (*r_mn_[i]).derivative(s) * cos_mn_i,  // drdu_mn_i
-            n_[i] * r_mn_i * sin_mn_i,  // drdv_mn_i
-            -m_[i] * r_mn_i * sin_mn_i,  // drdw_mn_i
-            (*z_mn_[i]).derivative(s) * sin_mn_i,  // dzdu_mn_i
-            -n_[i] * z_mn_i * cos_mn_i,  // dzdv_mn_i
-            m_[i] * z_mn_i * cos_mn_i  // dzdw_mn_i
-        };
+        std::complex<double> cis_mn_i = cis_mn[truncation_.first[i]];
+        return this->del_term(
+            i, this->radial_term(i, radial), std::real(cis_mn_i),
+            angles.parity * std::imag(cis_mn_i));
       });
-  double sin_zeta = std::sin(zeta), cos_zeta = std::cos(zeta);
-  return {
-      a.drdu * cos_zeta, a.drdv * cos_zeta - a.r * sin_zeta, a.drdw * cos_zeta,
-      a.drdu * sin_zeta, a.drdv * sin_zeta + a.r * cos_zeta, a.drdw * sin_zeta,
-      a.dzdu, a.dzdv, a.dzdw};
+  return morphism_vmec::del_from(a, std::cos(zeta), std::sin(zeta));
 }
 
 ddIR3 morphism_vmec::ddel(const IR3& q) const {
   double s = q[IR3::u], zeta = q[IR3::v], theta = q[IR3::w];
-  const auto& cis_mn = morphism_vmec::cached_cis(theta, zeta);
+  context_vmec::reduced_t angles = context_.reduce(theta, zeta);
+  auto cis_mn = context_.cis(angles.theta, angles.zeta);
+  const auto& radial = radial_(s, context_.cell(s));
   auto a = std::transform_reduce(
       index_.begin(), index_.end(),
-      aux_ddel_t {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+      aux_ddel_t {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
       std::plus<>(), [&](size_t i) -> aux_ddel_t {
-        double r_mn_i = (*r_mn_[i])(s), z_mn_i = (*z_mn_[i])(s);
-        double cos_mn_i = std::real(cis_mn[i]), sin_mn_i = std::imag(cis_mn[i]);
-        double drdu_mn_i = (*r_mn_[i]).derivative(s);
-        double dzdu_mn_i = (*z_mn_[i]).derivative(s);
-        double d2rdudu_mn_i = (*r_mn_[i]).derivative2(s);
-        double d2zdudu_mn_i = (*z_mn_[i]).derivative2(s);
-        return {
-            r_mn_i * cos_mn_i,  // r_mn_i
-            drdu_mn_i * cos_mn_i,  // drdu_mn_i
-            n_[i] * r_mn_i * sin_mn_i,  // drdv_mn_i
-            -m_[i] * r_mn_i * sin_mn_i,  // drdw_mn_i
-            dzdu_mn_i * sin_mn_i,  // dzdu_mn_i
-            -n_[i] * z_mn_i * cos_mn_i,  // dzdv_mn_i
-            m_[i] * z_mn_i * cos_mn_i,  // dzdw_mn_i
-            d2rdudu_mn_i * cos_mn_i,  // d2rdudu_mn_i
-            n_[i] * drdu_mn_i * sin_mn_i,  // d2rdudv_mn_i
-            -m_[i] * drdu_mn_i * sin_mn_i,  // d2rdudw_mn_i
-            -n_[i] * n_[i] * r_mn_i * cos_mn_i,  // d2rdvdv_mn_i
-            m_[i] * n_[i] * r_mn_i * cos_mn_i,  // d2rdvdw_mn_i
-            -m_[i] * m_[i] * r_mn_i * cos_mn_i,  // d2rdwdw_mn_i
-            d2zdudu_mn_i * sin_mn_i,  // dzdudu_mn_i
-            -n_[i] * dzdu_mn_i * cos_mn_i,  // dzdudv_mn_i
-            m_[i] * dzdu_mn_i * cos_mn_i,  // dzdudw_mn_i
-            -n_[i] * n_[i] * z_mn_i * sin_mn_i,  // dzdvdv_mn_i
-            m_[i] * n_[i] * z_mn_i * sin_mn_i,  // dzdvdw_mn_i
-            -m_[i] * m_[i] * z_mn_i * sin_mn_i  // dzdwdw_mn_i
-        };
+        std::complex<double> cis_mn_i = cis_mn[truncation_.first[i]];
+        return this->ddel_term(
+            i, this->radial_term(i, radial), std::real(cis_mn_i),
+            angles.parity * std::imag(cis_mn_i));
       });
-  double sin_zeta = std::sin(zeta), cos_zeta = std::cos(zeta);
+  return morphism_vmec::ddel_from(a, std::cos(zeta), std::sin(zeta));
+}
+
+//! Position and its first and second derivatives, from a single pass.
+/*!
+    The result is memoised per thread until `q` changes, such that the
+    `metric_vmec` members evaluated at the same point share the same pass over
+    the harmonics. If `with_ddel` is not set, the second derivatives are
+    skipped (and `ddel` is left null) unless already memoised at `q`, a later
+    call requiring them at the same point redoing the pass.
+*/
+const morphism_vmec::geometry_bundle& morphism_vmec::geometry(
+    const IR3& q, bool with_ddel) const {
+  geometry_memo_t& memo = geometry_memo_.local();
+  if (q[IR3::u] == memo.q[IR3::u] && q[IR3::v] == memo.q[IR3::v] &&
+      q[IR3::w] == memo.q[IR3::w] && (memo.with_ddel || !with_ddel))
+    return memo.geometry;
+  double s = q[IR3::u], zeta = q[IR3::v], theta = q[IR3::w];
+  context_vmec::reduced_t angles = context_.reduce(theta, zeta);
+  auto cis_mn = context_.cis(angles.theta, angles.zeta);
+  const auto& radial = radial_(s, context_.cell(s));
+  double cos_zeta = std::cos(zeta), sin_zeta = std::sin(zeta);
+  if (!with_ddel) {
+    auto a = std::transform_reduce(
+        index_.begin(), index_.end(), aux_del_t {0, 0, 0, 0, 0, 0, 0, 0},
+        std::plus<>(), [&](size_t i) -> aux_del_t {
+          std::complex<double> cis_mn_i = cis_mn[truncation_.first[i]];
+          return this->del_term(
+              i, this->radial_term(i, radial), std::real(cis_mn_i),
+              angles.parity * std::imag(cis_mn_i));
+        });
+    memo.geometry = {
+        {a.r * cos_zeta, a.r * sin_zeta, a.z},
+        morphism_vmec::del_from(a, cos_zeta, sin_zeta), {}, a.r, a.z};
+  } else {
+    auto a = std::transform_reduce(
+        index_.begin(), index_.end(),
+        aux_ddel_t {
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+        std::plus<>(), [&](size_t i) -> aux_ddel_t {
+          std::complex<double> cis_mn_i = cis_mn[truncation_.first[i]];
+          return this->ddel_term(
+              i, this->radial_term(i, radial), std::real(cis_mn_i),
+              angles.parity * std::imag(cis_mn_i));
+        });
+    aux_del_t b = {
+        a.r, a.drdu, a.drdv, a.drdw, a.dzdu, a.dzdv, a.dzdw, a.z};
+    memo.geometry = {
+        {a.r * cos_zeta, a.r * sin_zeta, a.z},
+        morphism_vmec::del_from(b, cos_zeta, sin_zeta),
+        morphism_vmec::ddel_from(a, cos_zeta, sin_zeta), a.r, a.z};
+  }
+  memo.q = q;
+  memo.with_ddel = with_ddel;
+  return memo.geometry;
+}
+
+//! Batched cartesian position, looping over harmonics first in each chunk.
+void morphism_vmec::eval_batch(
+    const IR3span& q, std::span<IR3> out) const {
+  check_batch_size(q, out);
+  for (size_t first = 0; first < q.size(); first += context_vmec::chunk_size) {
+    IR3span chunk = q.subspan(first, context_vmec::chunk_size);
+    size_t n = chunk.size();
+    auto s = chunk.u(), zeta = chunk.v();
+    auto cis = context_.cis_batch(chunk, truncation_.first, false);
+    auto cells = this->radial_cells(s);
+    std::array<aux_rz_t, context_vmec::chunk_size> a;
+    a.fill({0, 0});
+    for (size_t i : index_)
+      for (size_t p = 0; p < n; p++) {
+        aux_radial_t x = this->radial_term(i, cells[p], s[p]);
+        a[p] = a[p] +
+            aux_rz_t {
+                x.r * std::real(cis[i * n + p]),
+                x.z * std::imag(cis[i * n + p])};
+      }
+    for (size_t p = 0; p < n; p++)
+      out[first + p] = {
+          a[p].r * std::cos(zeta[p]), a[p].r * std::sin(zeta[p]), a[p].z};
+  }
+}
+
+//! Batched first derivatives, looping over harmonics first in each chunk.
+void morphism_vmec::del_batch(
+    const IR3span& q, std::span<dIR3> out) const {
+  check_batch_size(q, out);
+  for (size_t first = 0; first < q.size(); first += context_vmec::chunk_size) {
+    IR3span chunk = q.subspan(first, context_vmec::chunk_size);
+    size_t n = chunk.size();
+    auto s = chunk.u(), zeta = chunk.v();
+    auto cis = context_.cis_batch(chunk, truncation_.first, false);
+    auto cells = this->radial_cells(s);
+    std::array<aux_del_t, context_vmec::chunk_size> a;
+    a.fill({0, 0, 0, 0, 0, 0, 0, 0});
+    for (size_t i : index_)
+      for (size_t p = 0; p < n; p++)
+        a[p] = a[p] +
+            this->del_term(
+                i, this->radial_term(i, cells[p], s[p]),
+                std::real(cis[i * n + p]), std::imag(cis[i * n + p]));
+    for (size_t p = 0; p < n; p++)
+      out[first + p] = morphism_vmec::del_from(
+          a[p], std::cos(zeta[p]), std::sin(zeta[p]));
+  }
+}
+
+//! Batched second derivatives, looping over harmonics first in each chunk.
+void morphism_vmec::ddel_batch(
+    const IR3span& q, std::span<ddIR3> out) const {
+  check_batch_size(q, out);
+  for (size_t first = 0; first < q.size(); first += context_vmec::chunk_size) {
+    IR3span chunk = q.subspan(first, context_vmec::chunk_size);
+    size_t n = chunk.size();
+    auto s = chunk.u(), zeta = chunk.v();
+    auto cis = context_.cis_batch(chunk, truncation_.first, false);
+    auto cells = this->radial_cells(s);
+    std::array<aux_ddel_t, context_vmec::chunk_size> a;
+    a.fill({0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0});
+    for (size_t i : index_)
+      for (size_t p = 0; p < n; p++)
+        a[p] = a[p] +
+            this->ddel_term(
+                i, this->radial_term(i, cells[p], s[p]),
+                std::real(cis[i * n + p]), std::imag(cis[i * n + p]));
+    for (size_t p = 0; p < n; p++)
+      out[first + p] = morphism_vmec::ddel_from(
+          a[p], std::cos(zeta[p]), std::sin(zeta[p]));
+  }
+}
+
+//! Radial cells of the flux values `s` of a chunk.
+std::array<size_t, context_vmec::chunk_size> morphism_vmec::radial_cells(
+    std::span<const double> s) const {
+  std::array<size_t, context_vmec::chunk_size> cells;
+  for (size_t p = 0; p < s.size(); p++) cells[p] = radial_.cell(s[p]);
+  return cells;
+}
+
+//! Batched jacobian, built on one `del_batch` call per chunk.
+void morphism_vmec::jacobian_batch(
+    const IR3span& q, std::span<double> out) const {
+  check_batch_size(q, out);
+  std::array<dIR3, context_vmec::chunk_size> e;
+  for (size_t first = 0; first < q.size(); first += context_vmec::chunk_size) {
+    IR3span chunk = q.subspan(first, context_vmec::chunk_size);
+    this->del_batch(chunk, e);
+    for (size_t p = 0; p < chunk.size(); p++)
+      out[first + p] = gyronimo::determinant(e[p]);
+  }
+}
+
+//! Contribution of the `i`-th harmonic to @f$\{R,\partial R,\partial Z,Z\}@f$.
+morphism_vmec::aux_del_t morphism_vmec::del_term(
+    size_t i, const aux_radial_t& x, double cos_mn_i, double sin_mn_i) const {
+  double r_mn_i = x.r, z_mn_i = x.z;
+  return {
+      r_mn_i * cos_mn_i,  // r_mn_i
+      x.drdu * cos_mn_i,  // drdu_mn_i
+      n_[i] * r_mn_i * sin_mn_i,  // drdv_mn_i
+      -m_[i] * r_mn_i * sin_mn_i,  // drdw_mn_i
+      x.dzdu * sin_mn_i,  // dzdu_mn_i
+      -n_[i] * z_mn_i * cos_mn_i,  // dzdv_mn_i
+      m_[i] * z_mn_i * cos_mn_i,  // dzdw_mn_i
+      z_mn_i * sin_mn_i  // z_mn_i
+  };
+}
+
+//! Contribution of the `i`-th harmonic to the second derivatives.
+morphism_vmec::aux_ddel_t morphism_vmec::ddel_term(
+    size_t i, const aux_radial_t& x, double cos_mn_i, double sin_mn_i) const {
+  double r_mn_i = x.r, z_mn_i = x.z;
+  double drdu_mn_i = x.drdu, dzdu_mn_i = x.dzdu;
+  double d2rdudu_mn_i = x.d2rdudu, d2zdudu_mn_i = x.d2zdudu;
+  return {
+      r_mn_i * cos_mn_i,  // r_mn_i
+      drdu_mn_i * cos_mn_i,  // drdu_mn_i
+      n_[i] * r_mn_i * sin_mn_i,  // drdv_mn_i
+      -m_[i] * r_mn_i * sin_mn_i,  // drdw_mn_i
+      dzdu_mn_i * sin_mn_i,  // dzdu_mn_i
+      -n_[i] * z_mn_i * cos_mn_i,  // dzdv_mn_i
+      m_[i] * z_mn_i * cos_mn_i,  // dzdw_mn_i
+      d2rdudu_mn_i * cos_mn_i,  // d2rdudu_mn_i
+      n_[i] * drdu_mn_i * sin_mn_i,  // d2rdudv_mn_i
+      -m_[i] * drdu_mn_i * sin_mn_i,  // d2rdudw_mn_i
+      -n_[i] * n_[i] * r_mn_i * cos_mn_i,  // d2rdvdv_mn_i
+      m_[i] * n_[i] * r_mn_i * cos_mn_i,  // d2rdvdw_mn_i
+      -m_[i] * m_[i] * r_mn_i * cos_mn_i,  // d2rdwdw_mn_i
+      d2zdudu_mn_i * sin_mn_i,  // dzdudu_mn_i
+      -n_[i] * dzdu_mn_i * cos_mn_i,  // dzdudv_mn_i
+      m_[i] * dzdu_mn_i * cos_mn_i,  // dzdudw_mn_i
+      -n_[i] * n_[i] * z_mn_i * sin_mn_i,  // dzdvdv_mn_i
+      m_[i] * n_[i] * z_mn_i * sin_mn_i,  // dzdvdw_mn_i
+      -m_[i] * m_[i] * z_mn_i * sin_mn_i,  // dzdwdw_mn_i
+      z_mn_i * sin_mn_i  // z_mn_i
+  };
+}
+
+//! Cartesian first derivatives from the summed cylindrical ones.
+dIR3 morphism_vmec::del_from(
+    const aux_del_t& a, double cos_zeta, double sin_zeta) {
+  return {
+      a.drdu * cos_zeta, a.drdv * cos_zeta - a.r * sin_zeta, a.drdw * cos_zeta,
+      a.drdu * sin_zeta, a.drdv * sin_zeta + a.r * cos_zeta, a.drdw * sin_zeta,
+      a.dzdu, a.dzdv, a.dzdw};
+}
+
+//! Cartesian second derivatives from the summed cylindrical ones.
+ddIR3 morphism_vmec::ddel_from(
+    const aux_ddel_t& a, double cos_zeta, double sin_zeta) {
   return {
       a.d2rdudu * cos_zeta, a.d2rdudv * cos_zeta - a.drdu * sin_zeta,
       a.d2rdudw * cos_zeta,
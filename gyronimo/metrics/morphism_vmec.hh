@@ -20,13 +20,18 @@
 #ifndef GYRONIMO_MORPHISM_VMEC
 #define GYRONIMO_MORPHISM_VMEC
 
-#include <gyronimo/interpolators/interpolator1d.hh>
+#include <gyronimo/core/per_thread.hh>
+#include <gyronimo/interpolators/spline1d_array.hh>
+#include <gyronimo/metrics/context_vmec.hh>
 #include <gyronimo/metrics/morphism.hh>
 #include <gyronimo/parsers/parser_vmec.hh>
 
+#include <array>
 #include <complex>
+#include <limits>
 #include <memory>
 #include <numbers>
+#include <optional>
 
 namespace gyronimo {
 
@@ -39,44 +44,136 @@ namespace gyronimo {
     when looking from the torus top, and an angle on the poloidal cross section
     (`w`, or `VMEC` @f$\theta@f$, also in rads). More info at the website
     [STELLOPT](https://princetonuniversity.github.io/STELLOPT/VMEC.html).
+    The radial interpolators built by `ifactory` for `rmnc` and `zmns` are
+    stored as a single `spline1d_array`, whose values and first and second
+    derivatives for all harmonics are produced by one sweep after a single
+    radial cell search. Batched evaluations take chunks of positions with their
+    phase factors from `context_vmec::cis_batch()`, looping over harmonics first
+    and positions second within each chunk. The position and its first and
+    second derivatives at the same point can be obtained from a single
+    (memoised) pass over the harmonics with `geometry()`, which skips the
+    second derivatives if these are not required. The phase factors of
+    the harmonics come from a `context_vmec` owned by this object and shared
+    with the `metric_vmec` and `equilibrium_vmec` objects built upon it.
+    Harmonics with negligible amplitude may be dropped at construction (see the
+    constructor), in which case `harmonics()` returns the number of retained
+    ones. Optionally, the phase factors may be evaluated in the fundamental
+    domain of the field periods and stellarator symmetry (see `context_vmec`),
+    which also applies to the `equilibrium_vmec` objects built upon this one.
+    The inverse is found by Newton iterations on @f$(\sqrt{s},\theta)@f$ with
+    the analytic derivatives of @f$(R,Z)@f$, starting from the last solution
+    found by the calling thread (cold `inverse()`) or from the original point
+    (`translation()`), and falling back to a GSL hybrid solver if Newton fails;
+    `inverse_statistics()` returns per-thread counters for profiling. The built
+    state may be saved to a `snapshot` and restored from it by other runs
+    without rebuilding the splines.
 */
 class morphism_vmec : public morphism {
  public:
   using narray_type = parser_vmec::narray_type;
   morphism_vmec(
-      const parser_vmec* parser, const interpolator1d_factory* ifactory);
+      const parser_vmec* parser, const interpolator1d_factory* ifactory,
+      double tolerance = 0, bool symmetry = false, bool lazy = false);
+  morphism_vmec(
+      const parser_vmec* parser, const snapshot* s, bool symmetry = false);
   virtual ~morphism_vmec() override {};
   virtual IR3 operator()(const IR3& q) const override;
   virtual IR3 inverse(const IR3& x) const override;
   virtual dIR3 del(const IR3& q) const override;
   virtual ddIR3 ddel(const IR3& q) const override;
   virtual IR3 translation(const IR3& q, const IR3& delta) const override;
+  virtual void eval_batch(
+      const IR3span& q, std::span<IR3> out) const override;
+  virtual void del_batch(
+      const IR3span& q, std::span<dIR3> out) const override;
+  virtual void ddel_batch(
+      const IR3span& q, std::span<ddIR3> out) const override;
+  virtual void jacobian_batch(
+      const IR3span& q, std::span<double> out) const override;
 
   const parser_vmec* my_parser() const { return parser_; };
+  const context_vmec* context() const { return &context_; };
+  size_t harmonics() const { return harmonics_; };
+  double truncation_error() const { return truncation_.second; };
   std::pair<double, double> get_rz(const IR3& q) const;
+  void save(snapshot::writer& w) const;
+
+  //! Counters of the calling thread's inversions.
+  struct inverse_stats {
+    size_t solves = 0, iterations = 0, failures = 0, fallbacks = 0;
+  };
+  const inverse_stats& inverse_statistics() const {
+    return inverse_stats_.local();
+  };
+  void reset_inverse_statistics() const { inverse_stats_.local() = {}; };
+
+  //! Cartesian position and derivatives, with cylindrical `R` and `Z`.
+  struct geometry_bundle {
+    IR3 x = {0, 0, 0};
+    dIR3 del = {};
+    ddIR3 ddel = {};
+    double R = 0, Z = 0;
+  };
+  const geometry_bundle& geometry(const IR3& q, bool with_ddel = true) const;
  private:
   const parser_vmec* parser_;
+  const context_vmec context_;
+  const std::pair<std::vector<size_t>, double> truncation_;
   const size_t harmonics_;
   const narray_type m_, n_;
   std::vector<size_t> index_;
-  std::vector<std::unique_ptr<interpolator1d>> r_mn_, z_mn_;
+  const spline1d_array radial_;
+  struct geometry_memo_t {
+    IR3 q = {
+        std::numeric_limits<double>::quiet_NaN(),
+        std::numeric_limits<double>::quiet_NaN(),
+        std::numeric_limits<double>::quiet_NaN()};
+    geometry_bundle geometry;
+    bool with_ddel = false;
+  };
+  per_thread<geometry_memo_t> geometry_memo_;
+  struct inverse_hint_t {
+    double s = std::numeric_limits<double>::quiet_NaN();
+    double theta = std::numeric_limits<double>::quiet_NaN();
+  };
+  per_thread<inverse_hint_t> inverse_hint_;
+  per_thread<inverse_stats> inverse_stats_;
 
-  using cis_container_t = std::vector<std::complex<double>>;
-  const cis_container_t& cached_cis(double theta, double zeta) const;
   IR3 inverse(const IR3& x, const std::pair<double, double>& guess) const;
+  std::optional<std::pair<double, double>> newton_inverse(
+      double r, double z, double zeta,
+      const std::pair<double, double>& guess) const;
+  std::pair<double, double> multiroot_inverse(
+      double r, double z, double zeta,
+      const std::pair<double, double>& guess) const;
   std::pair<double, double> reflection_past_axis(
       double flux, double theta) const;
-  void build_interpolator_array(
-      std::vector<std::unique_ptr<interpolator1d>>& interpolator_array,
-      const narray_type& samples_array, const interpolator1d_factory* ifactory);
+  narray_type retained(const narray_type& x) const;
+  std::array<size_t, context_vmec::chunk_size> radial_cells(
+      std::span<const double> s) const;
+  struct aux_radial_t { double r, drdu, d2rdudu, z, dzdu, d2zdudu; };
   struct aux_rz_t { double r, z; };
-  struct aux_del_t { double r, drdu, drdv, drdw, dzdu, dzdv, dzdw; };
+  struct aux_inverse_t { double r, z, drdu, drdw, dzdu, dzdw; };
+  aux_inverse_t inverse_terms(double flux, double zeta, double theta) const;
+  struct aux_del_t { double r, drdu, drdv, drdw, dzdu, dzdv, dzdw, z; };
   struct aux_ddel_t {
     double r, drdu, drdv, drdw, dzdu, dzdv, dzdw;
     double d2rdudu, d2rdudv, d2rdudw, d2rdvdv, d2rdvdw, d2rdwdw;
     double d2zdudu, d2zdudv, d2zdudw, d2zdvdv, d2zdvdw, d2zdwdw;
+    double z;
   };
+  aux_radial_t radial_term(size_t i, const spline1d_array::values_t& v) const;
+  aux_radial_t radial_term(size_t i, size_t cell, double s) const;
+  aux_del_t del_term(
+      size_t i, const aux_radial_t& x, double cos_mn_i, double sin_mn_i) const;
+  aux_ddel_t ddel_term(
+      size_t i, const aux_radial_t& x, double cos_mn_i, double sin_mn_i) const;
+  static dIR3 del_from(const aux_del_t& a, double cos_zeta, double sin_zeta);
+  static ddIR3 ddel_from(
+      const aux_ddel_t& a, double cos_zeta, double sin_zeta);
   friend aux_rz_t operator+(const aux_rz_t& x, const aux_rz_t& y);
+  friend aux_inverse_t operator+(
+      const aux_inverse_t& x, const aux_inverse_t& y);
   friend aux_del_t operator+(const aux_del_t& x, const aux_del_t& y);
   friend aux_ddel_t operator+(const aux_ddel_t& x, const aux_ddel_t& y);
 };
@@ -103,10 +200,17 @@ inline morphism_vmec::aux_rz_t operator+(
   return {x.r + y.r, x.z + y.z};
 }
 
+inline morphism_vmec::aux_inverse_t operator+(
+    const morphism_vmec::aux_inverse_t& x,
+    const morphism_vmec::aux_inverse_t& y) {
+  return {x.r + y.r, x.z + y.z, x.drdu + y.drdu, x.drdw + y.drdw,
+          x.dzdu + y.dzdu, x.dzdw + y.dzdw};
+}
+
 inline morphism_vmec::aux_del_t operator+(
     const morphism_vmec::aux_del_t& x, const morphism_vmec::aux_del_t& y) {
   return {x.r + y.r, x.drdu + y.drdu, x.drdv + y.drdv, x.drdw + y.drdw,
-          x.dzdu + y.dzdu, x.dzdv + y.dzdv, x.dzdw + y.dzdw};
+          x.dzdu + y.dzdu, x.dzdv + y.dzdv, x.dzdw + y.dzdw, x.z + y.z};
 }
 
 inline morphism_vmec::aux_ddel_t operator+(
@@ -117,7 +221,7 @@ inline morphism_vmec::aux_ddel_t operator+(
       x.d2rdudv + y.d2rdudv, x.d2rdudw + y.d2rdudw, x.d2rdvdv + y.d2rdvdv,
       x.d2rdvdw + y.d2rdvdw, x.d2rdwdw + y.d2rdwdw, x.d2zdudu + y.d2zdudu,
       x.d2zdudv + y.d2zdudv, x.d2zdudw + y.d2zdudw, x.d2zdvdv + y.d2zdvdv,
-      x.d2zdvdw + y.d2zdvdw, x.d2zdwdw + y.d2zdwdw};
+      x.d2zdvdw + y.d2zdvdw, x.d2zdwdw + y.d2zdwdw, x.z + y.z};
 }
 
 }  // end namespace gyronimo
@@ -17,45 +17,62 @@
 
 // @parser_castor.cc, this file is part of ::gyronimo::
 
-#include <fstream>
-#include <gyronimo/core/error.hh>
-#include <gyronimo/core/io_streaming.hh>
+#include <gyronimo/core/mapped_file.hh>
 #include <gyronimo/parsers/parser_castor.hh>
 
 namespace gyronimo {
 
-//! Reads and parses a CASTOR ceig file by name.
-parser_castor::parser_castor(const std::string &filename) {
-  std::ifstream input_stream;
-  input_stream.open(filename);
-  if (input_stream.rdstate() != std::ios_base::goodbit)
-    error(__func__, __FILE__, __LINE__, "cannot open input file.", 1);
-  input_stream >> n_psi_ >> n_harm_ >> n_tor_
-      >> eigenvalue_real_ >> eigenvalue_imag_;
-  m_.resize(n_harm_); input_stream >> m_;
+//! Reads and parses a CASTOR ceig file by name, keeping only `variables`.
+parser_castor::parser_castor(const std::string &filename, unsigned variables) {
+  mapped_file file(filename);
+  tokeniser input(file.text());
+  n_psi_ = input.next<size_t>();
+  n_harm_ = input.next<size_t>();
+  n_tor_ = input.next<double>();
+  eigenvalue_real_ = input.next<double>();
+  eigenvalue_imag_ = input.next<double>();
+  m_.resize(n_harm_); input.read(m_);
   s_.resize(n_psi_);
-  this->initialise_variable_chunk(input_stream, v1_real_, v1_imag_);
-  this->initialise_variable_chunk(input_stream, v2_real_, v2_imag_);
-  this->initialise_variable_chunk(input_stream, v3_real_, v3_imag_);
+  this->initialise_variable_chunk(input, variables & v1, v1_real_, v1_imag_);
+  this->initialise_variable_chunk(input, variables & v2, v2_real_, v2_imag_);
+  this->initialise_variable_chunk(input, variables & v3, v3_real_, v3_imag_);
 
 // Shamefully, ceig stores -i*A1 instead of A1:
-  this->initialise_variable_chunk(input_stream, a1_imag_, a1_real_);
+  this->initialise_variable_chunk(input, variables & a1, a1_imag_, a1_real_);
   a1_imag_ *= -1.0;
 
 // Other components are ok:
-  this->initialise_variable_chunk(input_stream, a2_real_, a2_imag_);
-  this->initialise_variable_chunk(input_stream, a3_real_, a3_imag_);
-  this->initialise_variable_chunk(input_stream, rho_real_, rho_imag_);
-  this->initialise_variable_chunk(input_stream, t_real_, t_imag_);
+  this->initialise_variable_chunk(input, variables & a2, a2_real_, a2_imag_);
+  this->initialise_variable_chunk(input, variables & a3, a3_real_, a3_imag_);
+  this->initialise_variable_chunk(
+      input, variables & rho, rho_real_, rho_imag_);
+  this->initialise_variable_chunk(input, variables & t, t_real_, t_imag_);
 }
- 
+
+//! Reads (or skips, if not `keep`) the next n_psi*n_harm (s, real, imag).
+/*!
+    The radial grid `s`, repeated for every harmonic, is read from the first
+    one even if the chunk is skipped, the remaining samples of which are never
+    converted.
+*/
 void parser_castor::initialise_variable_chunk(
-    std::ifstream& input_stream, narray_type& real, narray_type& imag) {
+    tokeniser& input, bool keep, narray_type& real, narray_type& imag) {
+  if (!keep && n_harm_ > 0) {
+    for (size_t i = 0; i < n_psi_; i++) {
+      s_[i] = input.next<double>();
+      input.skip(2);
+    }
+    input.skip(3*n_psi_*(n_harm_ - 1));
+    return;
+  }
   real.resize(n_psi_*n_harm_);
   imag.resize(n_psi_*n_harm_);
   for (size_t m = 0; m < n_harm_; m++)
-    for (size_t i = 0; i < n_psi_; i++)
-      input_stream >> s_[i] >> real[i + m*n_psi_] >> imag[i + m*n_psi_];
+    for (size_t i = 0; i < n_psi_; i++) {
+      s_[i] = input.next<double>();
+      real[i + m*n_psi_] = input.next<double>();
+      imag[i + m*n_psi_] = input.next<double>();
+    }
 }
 
 } // end namespace gyronimo.
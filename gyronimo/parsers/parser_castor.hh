@@ -22,6 +22,7 @@
 
 #include <string>
 #include <valarray>
+#include <gyronimo/core/tokeniser.hh>
 
 namespace gyronimo {
 
@@ -32,13 +33,21 @@ namespace gyronimo {
     v1, v2, v3, a2, a3, t, and rho are provided as defined in the published
     paper. As an exception, a1 is provided as the true first covariant component
     of the vector potential, not the product -i*a1 stored in the ceig file.
+    Only the variables in the bitwise combination `variables` are stored (e.g.,
+    `vector_potential`, all that `eigenmode_castor_*` objects need), the others
+    being skipped without conversion and left as empty arrays. The radial grid
+    `s` and the poloidal numbers `m` are always available.
 */
 
 class parser_castor {
  public:
   typedef std::valarray<double> narray_type;
+  enum variable {
+      rho = 1, t = 2, v1 = 4, v2 = 8, v3 = 16, a1 = 32, a2 = 64, a3 = 128};
+  static constexpr unsigned vector_potential = a1 | a2 | a3;
+  static constexpr unsigned all = rho | t | v1 | v2 | v3 | vector_potential;
 
-  parser_castor(const std::string &filename);
+  parser_castor(const std::string &filename, unsigned variables = all);
   ~parser_castor() {};
 
   size_t n_psi() const {return n_psi_;};
@@ -75,7 +84,7 @@ class parser_castor {
   narray_type a1_real_, a1_imag_, a2_real_, a2_imag_, a3_real_, a3_imag_;
 
   void initialise_variable_chunk(
-      std::ifstream& input_stream, narray_type& real, narray_type& imag);
+      tokeniser& input, bool keep, narray_type& real, narray_type& imag);
 };
 
 } // end namespace gyronimo.
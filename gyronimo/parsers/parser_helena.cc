@@ -17,35 +17,38 @@
 
 // @parser_helena.cc, this file is part of ::gyronimo::
 
+#include <span>
 #include <numbers>
-#include <fstream>
-#include <gyronimo/core/error.hh>
-#include <gyronimo/core/io_streaming.hh>
+#include <algorithm>
+#include <gyronimo/core/mapped_file.hh>
 #include <gyronimo/parsers/parser_helena.hh>
 
 namespace gyronimo {
 
 //! Reads and parses a HELENA mapping file by name.
+/*!
+    The file is mapped into memory and tokenised in place (see `tokeniser`),
+    each array being read straight into its final storage.
+*/
 parser_helena::parser_helena(const std::string& filename) {
-  std::ifstream input_stream;
-  input_stream.open(filename);
-  if (input_stream.rdstate() != std::ios_base::goodbit)
-    error(__func__, __FILE__, __LINE__, "cannot open input file.", 1);
+  mapped_file file(filename);
+  tokeniser input(file.text());
 
-  input_stream >> npsi_; npsi_++;  // `HELENA` does't count the axis (s=0)...
-  s_.resize(npsi_); input_stream >> s_;  // ... but stores it (shame on you)!
-  q_.resize(npsi_); input_stream >> q_;
+  npsi_ = input.next<size_t>() + 1;  // `HELENA` does't count the axis (s=0)...
+  s_.resize(npsi_); input.read(s_);  // ... but stores it (shame on you)!
+  q_.resize(npsi_); input.read(q_);
 
 // Reads the dqs samples, which are stored in a rather peculiar form as:
 // dqs[0], dqec, dq[1], ..., dq[npsi_ - 1]
   dqs_.resize(npsi_);
-  input_stream >> dqec_;
-  input_stream >> dqs_;
+  dqec_ = input.next<double>();
+  input.read(dqs_);
   std::swap(dqec_, dqs_[0]);
 
-  curj_.resize(npsi_); input_stream >> curj_;
-  input_stream >> dj0_ >> dje_;
-  input_stream >> nchi_;
+  curj_.resize(npsi_); input.read(curj_);
+  dj0_ = input.next<double>();
+  dje_ = input.next<double>();
+  nchi_ = input.next<size_t>();
   is_symmetric_ = (nchi_ % 2 ? true : false);
 
 // The angle \pi is stored by `HELENA` for symmetric equilibria, but for
@@ -54,50 +57,51 @@ parser_helena::parser_helena(const std::string& filename) {
   chi_.resize(nchi_);
 
 // Reads in the poloidal angles and adds the last one according to the symmetry.
-  auto get_from_stream =
-    [&input_stream]() {double x; input_stream >> x; return x;};
-  std::generate(std::begin(chi_), (std::end(chi_) - 1), get_from_stream);
+  input.read(std::span<double>(std::begin(chi_), nchi_ - 1));
   if (is_symmetric_)  // symmetry exception...
-    input_stream >> chi_[nchi_ - 1];
+    chi_[nchi_ - 1] = input.next<double>();
   else
     chi_[nchi_ - 1] = 2*std::numbers::pi;
 
 // 2D fields are stored by `HELENA` without the row corresponding to the
 // magnetic axis and without the column corresponding to the angle 2*\pi if
 // not symmetric. Therefore, a special layout procedure is needed.
-  this->layout_2d_field(input_stream, gmh11_);
-  this->layout_2d_field(input_stream, gmh12_);
+  this->layout_2d_field(input, gmh11_);
+  this->layout_2d_field(input, gmh12_);
 
-  input_stream >> cpsurf_ >> radius_;
-  this->layout_2d_field(input_stream, gmh33_);
+  cpsurf_ = input.next<double>();
+  radius_ = input.next<double>();
+  this->layout_2d_field(input, gmh33_);
 
-  input_stream >> raxis_;  // sadly, HELENA always prints 1.0 here.
-  p0_.resize(npsi_); input_stream >> p0_;
-  input_stream >> dp0_ >> dpe_;
-  rbphi_.resize(npsi_); input_stream >> rbphi_;
-  input_stream >> drbphi0_ >> drbphie_;
+  raxis_ = input.next<double>();  // sadly, HELENA always prints 1.0 here.
+  p0_.resize(npsi_); input.read(p0_);
+  dp0_ = input.next<double>();
+  dpe_ = input.next<double>();
+  rbphi_.resize(npsi_); input.read(rbphi_);
+  drbphi0_ = input.next<double>();
+  drbphie_ = input.next<double>();
 
 // Reads in vaccum information and add the last angular value.
   vx_.resize(nchi_);
-  std::generate(std::begin(vx_), (std::end(vx_) - 1), get_from_stream);
+  input.read(std::span<double>(std::begin(vx_), nchi_ - 1));
   if (is_symmetric_)  // symmetry exception...
-    input_stream >> vx_[nchi_ - 1];
+    vx_[nchi_ - 1] = input.next<double>();
   else
     vx_[nchi_ - 1] = vx_[0];
   vy_.resize(nchi_);
-  std::generate(std::begin(vy_), (std::end(vy_) - 1), get_from_stream);
+  input.read(std::span<double>(std::begin(vy_), nchi_ - 1));
   if (is_symmetric_)  // symmetry exception...
-    input_stream >> vy_[nchi_ - 1];
+    vy_[nchi_ - 1] = input.next<double>();
   else
     vy_[nchi_ - 1] = vy_[0];
 
-  input_stream >> eps_;
+  eps_ = input.next<double>();
 
-  this->layout_2d_field(input_stream, x_);
-  this->layout_2d_field(input_stream, y_);
+  this->layout_2d_field(input, x_);
+  this->layout_2d_field(input, y_);
 
-  input_stream >> rmag_ >> bmag_;
-  input_stream.close();
+  rmag_ = input.next<double>();
+  bmag_ = input.next<double>();
 
   rgeo_ = radius_/eps_*rmag_;
   this->build_auxiliar_data();
@@ -118,35 +122,38 @@ double parser_helena::reduce_chi(double chi) const {
     flux-function 2D arrays.
 */
 void parser_helena::build_auxiliar_data() {
-  f_.resize(npsi_*nchi_);
-  F_.resize(npsi_*nchi_);
-  qoF_.resize(npsi_*nchi_);
-
-// Replicates 1d radial profiles over the 2d grid:
+  size_t size = npsi_*nchi_;
+  for (narray_type* array : {&f_, &F_, &qoF_, &J_,
+      &covariant_g11_, &covariant_g12_, &covariant_g22_, &covariant_g33_,
+      &covariant_B1_, &covariant_B2_, &covariant_B3_,
+      &contravariant_B1_, &contravariant_B2_, &contravariant_B3_})
+    array->resize(size);  // zero-filled, as required by contravariant_B1_.
+
+// Replicates 1d radial profiles over the 2d grid and combines them, one sample
+// at a time, with the metric samples (no temporary arrays):
   for (size_t row = 0; row < npsi_; row++) {
-    std::slice flux_surface(row*nchi_, nchi_, 1);
-    F_[flux_surface] = rbphi_[row];
-    f_[flux_surface] = 2.0*cpsurf_*s_[row];
-    qoF_[flux_surface] = q_[row]/rbphi_[row];
+    double F = rbphi_[row], f = 2.0*cpsurf_*s_[row], qoF = q_[row]/rbphi_[row];
+    for (size_t k = row*nchi_; k < (row + 1)*nchi_; k++) {
+      double g11 = gmh11_[k], g12 = gmh12_[k], g33 = gmh33_[k];
+      F_[k] = F;
+      f_[k] = f;
+      qoF_[k] = qoF;
+      J_[k] = f*qoF*g33;
+      covariant_g33_[k] = g33;
+      covariant_g22_[k] = qoF*qoF*g33*g11;
+      covariant_g12_[k] = -qoF*qoF*f*g33*g12;
+      covariant_g11_[k] = (1.0 + qoF*qoF*g12*g12*g33)*f*f/g11;
+      covariant_B1_[k] = -f*qoF*g12;
+      covariant_B2_[k] = qoF*g11;
+      covariant_B3_[k] = F;
+      contravariant_B2_[k] = 1.0/(qoF*g33);  // Note: f/J is indeterminate at 0!
+      contravariant_B3_[k] = F/g33;
+    }
   }
 
-  J_ = f_*qoF_*gmh33_;
-  covariant_g33_ = gmh33_;
-  covariant_g22_ = qoF_*qoF_*gmh33_*gmh11_;
-  covariant_g12_ = -qoF_*qoF_*f_*gmh33_*gmh12_;
-  covariant_g11_ = (1.0 + qoF_*qoF_*gmh12_*gmh12_*gmh33_)*f_*f_/gmh11_;
-
 // Corrects the indeterminate ratio at the axis:
-  covariant_g11_[std::slice(0, nchi_, 1)] =
-    this->axis_extrapolation(covariant_g11_);
-
-  covariant_B1_ = -f_*qoF_*gmh12_;
-  covariant_B2_ = qoF_*gmh11_;
-  covariant_B3_ = F_;
-
-  contravariant_B1_ = narray_type(0.0, nchi_*npsi_);
-  contravariant_B2_ = 1.0/(qoF_*gmh33_);  // Note: f_/J_ is indeterminate at 0!
-  contravariant_B3_ = F_/gmh33_;
+  std::fill_n(std::begin(covariant_g11_), nchi_,
+      this->axis_extrapolation(covariant_g11_));
 }
 
 //! Extrapolates the axis' row value from neighbouring points.
@@ -159,23 +166,17 @@ double parser_helena::axis_extrapolation(const narray_type& array) {
 
 //! Adds the axis row and the final angle column (if asym) to a 2D field.
 void parser_helena::layout_2d_field(
-    std::istream& input_stream, narray_type& composed_array) {
-  std::slice axis_row(0, nchi_, 1);
+    tokeniser& input, narray_type& composed_array) {
   size_t stored_nchi = (is_symmetric_ ? nchi_ : nchi_ - 1);
-  std::gslice inner_submatrix(nchi_, {npsi_ - 1, stored_nchi}, {nchi_, 1});
-
-  narray_type array_from_hmap(stored_nchi*(npsi_ - 1));
-  input_stream >> array_from_hmap;
-
   composed_array.resize(npsi_*nchi_);
-  composed_array[inner_submatrix] = array_from_hmap;
-  composed_array[axis_row] = this->axis_extrapolation(composed_array);
-
-  if (!is_symmetric_) {  // symmetry exception...
-    std::slice first_column(0, npsi_, nchi_);
-    std::slice last_column(nchi_ - 1, npsi_, nchi_);
-    composed_array[last_column] = composed_array[first_column];
-  }
+  for (size_t row = 1; row < npsi_; row++)
+    input.read(std::span<double>(&composed_array[row*nchi_], stored_nchi));
+  std::fill_n(std::begin(composed_array), nchi_,
+      this->axis_extrapolation(composed_array));
+
+  if (!is_symmetric_)  // symmetry exception...
+    for (size_t row = 0; row < npsi_; row++)
+      composed_array[row*nchi_ + nchi_ - 1] = composed_array[row*nchi_];
 }
 
 } // end namespace gyronimo.
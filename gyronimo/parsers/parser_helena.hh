@@ -23,6 +23,7 @@
 #include <string>
 #include <iostream>
 #include <valarray>
+#include <gyronimo/core/tokeniser.hh>
 
 namespace gyronimo {
 
@@ -115,7 +116,7 @@ class parser_helena {
 
   void build_auxiliar_data();
   double axis_extrapolation(const narray_type& array);
-  void layout_2d_field(std::istream& input_stream, narray_type& composed_array);
+  void layout_2d_field(tokeniser& input, narray_type& composed_array);
 };
 
 } // end namespace gyronimo.
@@ -24,42 +24,28 @@
 namespace gyronimo {
 
 //! Reads and parses a `VMEC` netcdf ouput file by name.
-parser_vmec::parser_vmec(const std::string& filename) {
+/*!
+    In `lazy` mode, reading the arrays is deferred to their first access.
+*/
+parser_vmec::parser_vmec(const std::string& filename, bool lazy) {
   try {
-    netCDF::NcFile dataFile(filename, netCDF::NcFile::read);
+    file_ = std::make_unique<netCDF::NcFile>(filename, netCDF::NcFile::read);
+    const netCDF::NcFile& dataFile = *file_;
     get_data(dataFile, "Aminor_p", Aminor_p_);
     get_data(dataFile, "Rmajor_p", Rmajor_p_);
     get_data(dataFile, "aspect", aspect_);
     get_data(dataFile, "b0", b0_);
-    get_data(dataFile, "bdotgradv", bdotgradv_);
-    get_data(dataFile, "beta_vol", beta_vol_);
     get_data(dataFile, "betapol", beta_pol_);
     get_data(dataFile, "betator", beta_tor_);
     get_data(dataFile, "betatotal", beta_total_);
     get_data(dataFile, "betaxis", beta_axis_);
-    get_data(dataFile, "buco", buco_);
-    get_data(dataFile, "bvco", bvco_);
-    get_data(dataFile, "chi", chi_);
-    get_data(dataFile, "iotaf", iotaf_);
-    get_data(dataFile, "iotas", iotas_);
-    get_data(dataFile, "jcuru", jcuru_);
-    get_data(dataFile, "jcurv", jcurv_);
-    get_data(dataFile, "jdotb", jdotb_);
     get_data(dataFile, "lasym__logical__", is_axisymmetric_);
-    get_data(dataFile, "mass", mass_);
     get_data(dataFile, "mnmax", mnmax_);
     get_data(dataFile, "mnmax_nyq", mnmax_nyq_);
     get_data(dataFile, "mpol", mpol_);
     get_data(dataFile, "nfp", nfp_);
     get_data(dataFile, "ns", ns_);
     get_data(dataFile, "ntor", ntor_);
-    get_data(dataFile, "phi", phi_);
-    get_data(dataFile, "phipf", phipf_);
-    get_data(dataFile, "phips", phips_);
-    get_data(dataFile, "pres", pres_);
-    get_data(dataFile, "presf", presf_);
-    get_data(dataFile, "q_factor", q_factor_);
-    get_data(dataFile, "raxis_cc", raxis_cc_);
     get_data(dataFile, "rbtor", rbtor_);
     get_data(dataFile, "rbtor0", rbtor0_);
     get_data(dataFile, "rmax_surf", rmax_surf_);
@@ -67,30 +53,51 @@ parser_vmec::parser_vmec(const std::string& filename) {
     get_data(dataFile, "signgs", signgs_);
     get_data(dataFile, "version_", version_);
     get_data(dataFile, "volume_p", volume_p_);
-    get_data(dataFile, "xm", xm_);
-    get_data(dataFile, "xm_nyq", xm_nyq_);
-    get_data(dataFile, "xn", xn_);
-    get_data(dataFile, "xn_nyq", xn_nyq_);
-    get_data(dataFile, "zaxis_cs", zaxis_cs_);
     get_data(dataFile, "zmax_surf", zmax_surf_);
-    get_data_2d(dataFile, "bmnc", bmnc_);
-    get_data_2d(dataFile, "bsubsmns", bsubsmns_);
-    get_data_2d(dataFile, "bsubumnc", bsubumnc_);
-    get_data_2d(dataFile, "bsubvmnc", bsubvmnc_);
-    get_data_2d(dataFile, "bsupumnc", bsupumnc_);
-    get_data_2d(dataFile, "bsupvmnc", bsupvmnc_);
-    get_data_2d(dataFile, "gmnc", gmnc_);
-    get_data_2d(dataFile, "lmns", lmns_);
-    get_data_2d(dataFile, "rmnc", rmnc_);
-    get_data_2d(dataFile, "zmns", zmns_);
+    if (!lazy) {
+      for (const variable_t* variable :
+           {&bdotgradv_, &beta_vol_, &buco_, &bvco_, &chi_, &iotaf_, &iotas_,
+            &jcuru_, &jcurv_, &jdotb_, &mass_, &phi_, &phipf_, &phips_, &pres_,
+            &presf_, &q_factor_, &raxis_cc_, &xm_, &xm_nyq_, &xn_, &xn_nyq_,
+            &zaxis_cs_, &bmnc_, &bsubsmns_, &bsubumnc_, &bsubvmnc_, &bsupumnc_,
+            &bsupvmnc_, &gmnc_, &lmns_, &rmnc_, &zmns_, &bdotb_, &chipf_,
+            &currumnc_, &currvmnc_, &phip_})
+        this->fetch(*variable);
+      file_.reset();
+    }
   } catch (netCDF::exceptions::NcException& e) {
     std::cout << e.what() << std::endl;
+    if (!lazy) file_.reset();
   }
   sgrid_ = linspace<narray_type>(0.0, 1.0, ns_);
   double ds_half_cell = 0.5 / (ns_ - 1);
   sgrid_half_cell_ =
       linspace<narray_type>(ds_half_cell, 1.0 - ds_half_cell, ns_ - 1);
 }
+
+//! Returns the data of `variable`, reading it from file on the first call.
+/*!
+    Reading is serialised by a single lock because the netcdf library is not
+    thread safe, the lock being skipped by all subsequent calls. Optional
+    variables absent from the file are left empty.
+*/
+const parser_vmec::narray_type& parser_vmec::fetch(
+    const variable_t& variable) const {
+  std::call_once(variable.once, [this, &variable]() {
+    static std::mutex netcdf_mutex;
+    std::lock_guard<std::mutex> lock(netcdf_mutex);
+    if (!file_)
+      error(__func__, __FILE__, __LINE__, " file already closed.", 1);
+    if (variable.optional && file_->getVar(variable.name).isNull()) return;
+    try {
+      if (variable.rank == 1) get_data(*file_, variable.name, variable.data);
+      else get_data_2d(*file_, variable.name, variable.data);
+    } catch (netCDF::exceptions::NcException& e) {
+      std::cout << e.what() << std::endl;
+    }
+  });
+  return variable.data;
+}
 void parser_vmec::get_data(
     const netCDF::NcFile& nc, const std::string& var, bool& out) {
   auto data = nc.getVar(var);
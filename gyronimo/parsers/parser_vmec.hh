@@ -20,8 +20,11 @@
 #ifndef GYRONIMO_PARSER_VMEC
 #define GYRONIMO_PARSER_VMEC
 
+#include <memory>
+#include <mutex>
 #include <netcdf>
 #include <string>
+#include <utility>
 #include <valarray>
 
 namespace gyronimo {
@@ -36,11 +39,27 @@ namespace gyronimo {
     stored fields can be found by running `ncdump -h wout_filename`. Parsed data
     is accessed via public member functions, some of them returning
     `parser_vmec::narray_type` arrays.
+
+    In `lazy` mode, only the scalars are read by the constructor, the file
+    being kept open and each array being read on the first call to its
+    accessor (once, even if several threads call it at the same time). Runs
+    needing a few arrays (e.g., `morphism_vmec` uses only `rmnc`, `zmns`,
+    `xm`, and `xn`) thus skip reading and storing all others. Otherwise, all
+    arrays are read by the constructor, which closes the file. The arrays
+    `bdotb`, `chipf`, `currumnc`, `currvmnc`, and `phip` are optional, being
+    left empty if absent from the file (earlier versions always left them
+    empty).
+
+    Owning the open file and a `std::once_flag` per array, `parser_vmec` is
+    neither copyable nor movable (earlier versions, without `lazy` mode, were
+    copyable). Dependent objects (e.g., `morphism_vmec`) keep a pointer to it.
 */
 class parser_vmec {
  public:
   typedef std::valarray<double> narray_type;
-  parser_vmec(const std::string& filename);
+  parser_vmec(const std::string& filename, bool lazy = false);
+  parser_vmec(const parser_vmec&) = delete;
+  parser_vmec& operator=(const parser_vmec&) = delete;
   ~parser_vmec() {};
 
   int signgs() const { return signgs_; };
@@ -68,47 +87,58 @@ class parser_vmec {
   double rmin_surf() const { return rmin_surf_; };
   double volume() const { return volume_p_; };
   double zmax_surf() const { return zmax_surf_; };
-  const narray_type& bdotb() const { return bdotb_; };
-  const narray_type& bdotgradv() const { return bdotgradv_; };
-  const narray_type& beta_vol() const { return beta_vol_; };
-  const narray_type& bmnc() const { return bmnc_; };
-  const narray_type& bsubsmns() const { return bsubsmns_; };
-  const narray_type& bsubumnc() const { return bsubumnc_; };
-  const narray_type& bsubvmnc() const { return bsubvmnc_; };
-  const narray_type& bsupumnc() const { return bsupumnc_; };
-  const narray_type& bsupvmnc() const { return bsupvmnc_; };
-  const narray_type& buco() const { return buco_; };
-  const narray_type& bvco() const { return bvco_; };
-  const narray_type& chi() const { return chi_; };
-  const narray_type& chipf() const { return chipf_; };
-  const narray_type& currumnc() const { return currumnc_; };
-  const narray_type& currvmnc() const { return currvmnc_; };
-  const narray_type& gmnc() const { return gmnc_; };
-  const narray_type& iotaf() const { return iotaf_; };
-  const narray_type& iotas() const { return iotas_; };
-  const narray_type& jcuru() const { return jcuru_; };
-  const narray_type& jcurv() const { return jcurv_; };
-  const narray_type& jdotb() const { return jdotb_; };
-  const narray_type& lmns() const { return lmns_; };
-  const narray_type& mass() const { return mass_; };
-  const narray_type& phi() const { return phi_; };
-  const narray_type& phip() const { return phip_; };
-  const narray_type& phipf() const { return phipf_; };
-  const narray_type& phips() const { return phips_; };
-  const narray_type& pres() const { return pres_; };
-  const narray_type& presf() const { return presf_; };
-  const narray_type& q() const { return q_factor_; };
+  const narray_type& bdotb() const { return this->fetch(bdotb_); };
+  const narray_type& bdotgradv() const { return this->fetch(bdotgradv_); };
+  const narray_type& beta_vol() const { return this->fetch(beta_vol_); };
+  const narray_type& bmnc() const { return this->fetch(bmnc_); };
+  const narray_type& bsubsmns() const { return this->fetch(bsubsmns_); };
+  const narray_type& bsubumnc() const { return this->fetch(bsubumnc_); };
+  const narray_type& bsubvmnc() const { return this->fetch(bsubvmnc_); };
+  const narray_type& bsupumnc() const { return this->fetch(bsupumnc_); };
+  const narray_type& bsupvmnc() const { return this->fetch(bsupvmnc_); };
+  const narray_type& buco() const { return this->fetch(buco_); };
+  const narray_type& bvco() const { return this->fetch(bvco_); };
+  const narray_type& chi() const { return this->fetch(chi_); };
+  const narray_type& chipf() const { return this->fetch(chipf_); };
+  const narray_type& currumnc() const { return this->fetch(currumnc_); };
+  const narray_type& currvmnc() const { return this->fetch(currvmnc_); };
+  const narray_type& gmnc() const { return this->fetch(gmnc_); };
+  const narray_type& iotaf() const { return this->fetch(iotaf_); };
+  const narray_type& iotas() const { return this->fetch(iotas_); };
+  const narray_type& jcuru() const { return this->fetch(jcuru_); };
+  const narray_type& jcurv() const { return this->fetch(jcurv_); };
+  const narray_type& jdotb() const { return this->fetch(jdotb_); };
+  const narray_type& lmns() const { return this->fetch(lmns_); };
+  const narray_type& mass() const { return this->fetch(mass_); };
+  const narray_type& phi() const { return this->fetch(phi_); };
+  const narray_type& phip() const { return this->fetch(phip_); };
+  const narray_type& phipf() const { return this->fetch(phipf_); };
+  const narray_type& phips() const { return this->fetch(phips_); };
+  const narray_type& pres() const { return this->fetch(pres_); };
+  const narray_type& presf() const { return this->fetch(presf_); };
+  const narray_type& q() const { return this->fetch(q_factor_); };
   const narray_type& sgrid() const { return sgrid_; };
   const narray_type& sgrid_half_cell() const { return sgrid_half_cell_; };
-  const narray_type& raxis_cc() const { return raxis_cc_; };
-  const narray_type& rmnc() const { return rmnc_; };
-  const narray_type& xm() const { return xm_; };
-  const narray_type& xm_nyq() const { return xm_nyq_; };
-  const narray_type& xn() const { return xn_; };
-  const narray_type& xn_nyq() const { return xn_nyq_; };
-  const narray_type& zaxis_cs() const { return zaxis_cs_; };
-  const narray_type& zmns() const { return zmns_; };
+  const narray_type& raxis_cc() const { return this->fetch(raxis_cc_); };
+  const narray_type& rmnc() const { return this->fetch(rmnc_); };
+  const narray_type& xm() const { return this->fetch(xm_); };
+  const narray_type& xm_nyq() const { return this->fetch(xm_nyq_); };
+  const narray_type& xn() const { return this->fetch(xn_); };
+  const narray_type& xn_nyq() const { return this->fetch(xn_nyq_); };
+  const narray_type& zaxis_cs() const { return this->fetch(zaxis_cs_); };
+  const narray_type& zmns() const { return this->fetch(zmns_); };
  private:
+  //! Array named `name`, with `rank` dimensions, read eagerly or on demand.
+  struct variable_t {
+    variable_t(std::string name, size_t rank, bool optional = false)
+        : name(std::move(name)), rank(rank), optional(optional) {};
+    std::string name;
+    size_t rank;
+    bool optional;
+    mutable std::once_flag once;
+    mutable narray_type data;
+  };
+  mutable std::unique_ptr<netCDF::NcFile> file_;
   int signgs_;
   bool is_axisymmetric_;
   size_t mnmax_;
@@ -132,59 +162,63 @@ class parser_vmec {
   double rmin_surf_;
   double volume_p_;
   double zmax_surf_;
-  narray_type bdotb_;
-  narray_type bdotgradv_;
+  variable_t bdotb_ = {"bdotb", 1, true};
+  variable_t bdotgradv_ = {"bdotgradv", 1};
   narray_type beta_;
-  narray_type beta_vol_;
-  narray_type bmnc_;
-  narray_type bsubsmns_;
-  narray_type bsubumnc_;
-  narray_type bsubvmnc_;
-  narray_type bsupumnc_;
-  narray_type bsupvmnc_;
-  narray_type buco_;
-  narray_type bvco_;
-  narray_type chi_;
-  narray_type chipf_;
-  narray_type currumnc_;
-  narray_type currvmnc_;
-  narray_type gmnc_;
+  variable_t beta_vol_ = {"beta_vol", 1};
+  variable_t bmnc_ = {"bmnc", 2};
+  variable_t bsubsmns_ = {"bsubsmns", 2};
+  variable_t bsubumnc_ = {"bsubumnc", 2};
+  variable_t bsubvmnc_ = {"bsubvmnc", 2};
+  variable_t bsupumnc_ = {"bsupumnc", 2};
+  variable_t bsupvmnc_ = {"bsupvmnc", 2};
+  variable_t buco_ = {"buco", 1};
+  variable_t bvco_ = {"bvco", 1};
+  variable_t chi_ = {"chi", 1};
+  variable_t chipf_ = {"chipf", 1, true};
+  variable_t currumnc_ = {"currumnc", 2, true};
+  variable_t currvmnc_ = {"currvmnc", 2, true};
+  variable_t gmnc_ = {"gmnc", 2};
   narray_type iota_;
-  narray_type iotaf_;
-  narray_type iotas_;
-  narray_type jcuru_;
-  narray_type jcurv_;
-  narray_type jdotb_;
-  narray_type lmns_;
-  narray_type mass_;
-  narray_type phi_;
-  narray_type phip_;
-  narray_type phipf_;
-  narray_type phips_;
-  narray_type pres_;
-  narray_type presf_;
-  narray_type q_factor_;
+  variable_t iotaf_ = {"iotaf", 1};
+  variable_t iotas_ = {"iotas", 1};
+  variable_t jcuru_ = {"jcuru", 1};
+  variable_t jcurv_ = {"jcurv", 1};
+  variable_t jdotb_ = {"jdotb", 1};
+  variable_t lmns_ = {"lmns", 2};
+  variable_t mass_ = {"mass", 1};
+  variable_t phi_ = {"phi", 1};
+  variable_t phip_ = {"phip", 1, true};
+  variable_t phipf_ = {"phipf", 1};
+  variable_t phips_ = {"phips", 1};
+  variable_t pres_ = {"pres", 1};
+  variable_t presf_ = {"presf", 1};
+  variable_t q_factor_ = {"q_factor", 1};
   narray_type sgrid_;
   narray_type sgrid_half_cell_;
-  narray_type raxis_cc_;
-  narray_type rmnc_;
-  narray_type xm_;
-  narray_type xm_nyq_;
-  narray_type xn_;
-  narray_type xn_nyq_;
-  narray_type zaxis_cs_;
-  narray_type zmns_;
+  variable_t raxis_cc_ = {"raxis_cc", 1};
+  variable_t rmnc_ = {"rmnc", 2};
+  variable_t xm_ = {"xm", 1};
+  variable_t xm_nyq_ = {"xm_nyq", 1};
+  variable_t xn_ = {"xn", 1};
+  variable_t xn_nyq_ = {"xn_nyq", 1};
+  variable_t zaxis_cs_ = {"zaxis_cs", 1};
+  variable_t zmns_ = {"zmns", 2};
 
-  void get_data(const netCDF::NcFile&, const std::string&, int&);
-  void get_data(const netCDF::NcFile&, const std::string&, bool&);
-  void get_data(const netCDF::NcFile&, const std::string&, size_t&);
-  void get_data(const netCDF::NcFile&, const std::string&, double&);
-  void get_data(const netCDF::NcFile&, const std::string&, narray_type&);
-  void get_data_2d(const netCDF::NcFile&, const std::string&, narray_type&);
+  const narray_type& fetch(const variable_t& variable) const;
+  static void get_data(const netCDF::NcFile&, const std::string&, int&);
+  static void get_data(const netCDF::NcFile&, const std::string&, bool&);
+  static void get_data(const netCDF::NcFile&, const std::string&, size_t&);
+  static void get_data(const netCDF::NcFile&, const std::string&, double&);
+  static void get_data(
+      const netCDF::NcFile&, const std::string&, narray_type&);
+  static void get_data_2d(
+      const netCDF::NcFile&, const std::string&, narray_type&);
 };
 
 inline double parser_vmec::cpsurf() const {
-  return chi_[chi_.size() - 1] / (rbtor0_ * rbtor0_ / b0_);
+  const narray_type& chi = this->chi();
+  return chi[chi.size() - 1] / (rbtor0_ * rbtor0_ / b0_);
 }
 
 }  // end namespace gyronimo.
@@ -0,0 +1,149 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @ensembletrace.cc, this file is part of ::gyronimo::
+
+// Command-line tool to trace guiding-centre ensembles in `VMEC` equilibria.
+// External dependencies:
+// - [argh](https://github.com/adishavit/argh), a minimalist argument handler.
+// - [GSL](https://www.gnu.org/software/gsl), the GNU Scientific Library.
+// - [boost](https://www.boost.org), the boost library.
+// - [netcdf-c++4] (https://github.com/Unidata/netcdf-cxx4.git).
+
+#include <gyronimo/core/codata.hh>
+#include <gyronimo/dynamics/ensemble.hh>
+#include <gyronimo/dynamics/guiding_centre.hh>
+#include <gyronimo/fields/equilibrium_vmec.hh>
+#include <gyronimo/interpolators/cubic_gsl.hh>
+#include <gyronimo/parsers/parser_vmec.hh>
+#include <gyronimo/version.hh>
+
+#include <argh.h>
+#include <vmec_objects.hh>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+using namespace gyronimo;
+
+void print_help() {
+  std::cout << "ensembletrace, powered by ::gyronimo::v" << version_major
+            << "." << version_minor << "." << version_patch
+            << " (git-commit:" << git_commit_hash << ").\n";
+  std::string help_message =
+      "usage: ensembletrace [options] vmec_netcdf_file < initial_positions\n"
+      "reads a vmec output file and a list of initial positions from stdin,\n"
+      "one \"flux zeta theta\" triplet per line, traces all guiding-centre\n"
+      "orbits in parallel and prints their final states to stdout.\n"
+      "options:\n"
+      "  -lref= Reference length (in si, default 1).\n"
+      "  -vref= Reference velocity (in si, default 1).\n"
+      "  -mass= Particle mass (in m_proton, default 1).\n"
+      "  -charge=\n"
+      "         Particle charge (in q_proton, default 1).\n"
+      "  -energy=, -lambda=\n"
+      "         Energy (eV) and lambda signed as v_parallel (default 1).\n"
+      "  -tfinal=, -steps=\n"
+      "         Time limit (lref/vref, default 1) and steps (default 512).\n"
+      "  -threads=\n"
+      "         Number of worker threads (default 0, all available cores).\n"
+      "  -shared=\n"
+      "         Shared-memory snapshot name (e.g., /w7x): the equilibrium is\n"
+      "         built by the first process and restored by all others on the\n"
+      "         node; it persists until removed (rm /dev/shm/w7x).\n"
+      "  Notes: lambda=magnetic_moment_si*B_axis_si/energy_si;\n"
+      "         orbits are stopped (lost) once flux exceeds unity.\n";
+  std::cout << help_message;
+  std::exit(0);
+}
+
+int main(int argc, char* argv[]) {
+  auto command_line = argh::parser(argv);
+  if (command_line[{"h", "help"}]) print_help();
+  if (!command_line(1)) {  // the 1st non-option argument is the mapping file.
+    std::cout << "ensembletrace: no vmec equilibrium file provided; -h for "
+                 "help.\n";
+    std::exit(1);
+  }
+  cubic_gsl_factory ifactory;
+  parser_vmec parser(command_line[1], true);  // reads only what is used.
+  vmec_objects vmec =
+      build_vmec_objects(parser, ifactory, command_line("shared").str());
+  const equilibrium_vmec* veq = vmec.veq.get();
+
+  double mass, lref, vref, tfinal, charge, energy, lambda;
+  command_line("mass", 1.0) >> mass;
+  command_line("lref", 1.0) >> lref;
+  command_line("vref", 1.0) >> vref;
+  command_line("tfinal", 1.0) >> tfinal;
+  command_line("charge", 1.0) >> charge;
+  command_line("energy", 1.0) >> energy;
+  command_line("lambda", 1.0) >> lambda;
+  double vpp_sign = std::copysign(1.0, lambda);  // lambda carries vpp sign.
+  lambda = std::abs(lambda);  // once vpp sign is stored, lambda turns unsigned.
+  size_t nsteps, nthreads;
+  command_line("steps", 512) >> nsteps;
+  command_line("threads", 0) >> nthreads;
+
+  double energy_ref = 0.5 * codata::m_proton * mass * vref * vref;
+  double energy_si = energy * codata::e;
+  guiding_centre gc(
+      lref, vref, charge / mass, lambda * energy_si / energy_ref, veq, nullptr);
+
+  std::vector<guiding_centre::state> initial_states;
+  double flux, zeta, theta;
+  while (std::cin >> flux >> zeta >> theta)
+    initial_states.push_back(gc.generate_state(
+        {flux, zeta, theta}, energy_si / energy_ref,
+        (vpp_sign > 0 ? guiding_centre::plus : guiding_centre::minus), 0));
+
+  ensemble<guiding_centre> tracer(&gc, nthreads);
+  double lost_flux = 1.0 / lref;  // state positions are normalised to lref.
+  auto is_lost = [lost_flux](const guiding_centre::state& s, double) {
+    return s[0] > lost_flux;
+  };
+  auto start = std::chrono::steady_clock::now();
+  auto orbits = tracer(initial_states, tfinal, tfinal / nsteps, is_lost);
+  std::chrono::duration<double> wall_time =
+      std::chrono::steady_clock::now() - start;
+
+  std::cout << "# ensembletrace, powered by ::gyronimo::v" << version_major
+            << "." << version_minor << "." << version_patch
+            << " (git-commit:" << git_commit_hash << ").\n";
+  std::cout << "# args: ";
+  for (int i = 1; i < argc; i++) std::cout << argv[i] << " ";
+  std::cout << std::endl
+            << "# E_ref: " << energy_ref << " [J]"
+            << " B_axis: " << veq->m_factor() << " [T]"
+            << " mu_tilde: " << gc.mu_tilde() << '\n'
+            << "# orbits: " << orbits.size() << " threads: " << tracer.threads()
+            << " wall_time: " << wall_time.count() << " [s]\n";
+  std::cout << "# vars: orbit outcome(0:completed,1:lost,2:diverged) t flux "
+               "zeta theta vpp\n";
+
+  std::cout.precision(16);
+  std::cout.setf(std::ios::scientific);
+  for (size_t i = 0; i < orbits.size(); i++) {
+    IR3 q = gc.get_position(orbits[i].final_state);
+    std::cout << i << " " << orbits[i].status << " " << orbits[i].final_time
+              << " " << q[IR3::u] << " " << q[IR3::v] << " " << q[IR3::w]
+              << " " << gc.get_vpp(orbits[i].final_state) << '\n';
+  }
+
+  return 0;
+}
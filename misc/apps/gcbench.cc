@@ -0,0 +1,146 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @gcbench.cc, this file is part of ::gyronimo::
+
+// Command-line tool to benchmark virtual vs static dispatch of the equations
+// of motion on an analytic circular equilibrium.
+// External dependencies:
+// - [argh](https://github.com/adishavit/argh), a minimalist argument handler.
+
+#include <gyronimo/core/codata.hh>
+#include <gyronimo/dynamics/guiding_centre_t.hh>
+#include <gyronimo/dynamics/lorentz_t.hh>
+#include <gyronimo/fields/equilibrium_circular.hh>
+#include <gyronimo/metrics/morphism_polar_torus.hh>
+#include <gyronimo/version.hh>
+
+#include <argh.h>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <numbers>
+#include <random>
+#include <vector>
+
+using namespace gyronimo;
+
+void print_help() {
+  std::cout << "gcbench, powered by ::gyronimo::v" << version_major << "."
+            << version_minor << "." << version_patch
+            << " (git-commit:" << git_commit_hash << ").\n";
+  std::string help_message =
+      "usage: gcbench [options]\n"
+      "evaluates the guiding-centre and lorentz equations of motion on a\n"
+      "circular equilibrium at random states, both with virtual dispatch\n"
+      "(guiding_centre, lorentz) and with static dispatch (guiding_centre_t,\n"
+      "lorentz_t), printing timings and the largest mismatch found.\n"
+      "options:\n"
+      "  -samples=\n"
+      "         Number of random states (default 1000).\n"
+      "  -repeats=\n"
+      "         Number of sweeps over all states (default 1000).\n"
+      "  -rmin=, -rmaj=, -b0=\n"
+      "         Minor and major radii (m, defaults 1 and 3), on-axis field\n"
+      "         (T, default 1).\n";
+  std::cout << help_message;
+  std::exit(0);
+}
+
+//! Returns the mean time per call [ns] and the largest mismatch.
+template<typename F1, typename F2, typename State>
+std::array<double, 3> time_systems(
+    const F1& f1, const F2& f2, const std::vector<State>& states,
+    size_t repeats) {
+  double mismatch = 0, checksum = 0;
+  for (const State& s : states) {
+    State x1 = f1(s, 0), x2 = f2(s, 0);
+    for (size_t k = 0; k < s.size(); k++)
+      mismatch = std::max(mismatch, std::abs(x1[k] - x2[k]));
+  }
+  auto timer = [&](const auto& f) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < repeats; i++)
+      for (const State& s : states) checksum += f(s, 0)[s.size() - 1];
+    std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count() / (repeats * states.size());
+  };
+  double t1 = timer(f1), t2 = timer(f2);
+  if (!std::isfinite(checksum)) std::cout << "# non-finite checksum.\n";
+  return {t1, t2, mismatch};
+}
+
+int main(int argc, char* argv[]) {
+  auto command_line = argh::parser(argv);
+  if (command_line[{"h", "help"}]) print_help();
+  size_t samples, repeats;
+  command_line("samples", 1000) >> samples;
+  command_line("repeats", 1000) >> repeats;
+  double rmin, rmaj, b0;
+  command_line("rmin", 1.0) >> rmin;
+  command_line("rmaj", 3.0) >> rmaj;
+  command_line("b0", 1.0) >> b0;
+
+  morphism_polar_torus morph(rmin, rmaj);
+  metric_polar_torus g(&morph);
+  auto q = [](double r) { return 1.0 + r * r; };
+  auto qprime = [](double r) { return 2.0 * r; };
+  equilibrium_circular eq(b0, &g, q, qprime);
+
+  double vref = 1.0e6, energy_ref = 0.5 * codata::m_proton * vref * vref;
+  guiding_centre gc(rmin, vref, 1.0, 0.5 / b0, &eq, nullptr);
+  guiding_centre_t<equilibrium_circular> gc_t(
+      rmin, vref, 1.0, 0.5 / b0, &eq, nullptr);
+  lorentz lz(rmin, vref, 1.0, &eq, nullptr);
+  lorentz_t<equilibrium_circular, metric_polar_torus> lz_t(
+      rmin, vref, 1.0, &eq, nullptr);
+
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> radius(0.05, 0.95),
+      angle(0.0, 2 * std::numbers::pi), velocity(-1.0, 1.0);
+  std::vector<guiding_centre::state> gc_states;
+  std::vector<lorentz::state> lz_states;
+  for (size_t i = 0; i < samples; i++) {
+    IR3 position = {radius(generator), angle(generator), angle(generator)};
+    gc_states.push_back(gc.generate_state(
+        position, 1.0, (i % 2 ? guiding_centre::plus : guiding_centre::minus),
+        0));
+    lz_states.push_back(lz.generate_state(
+        position, {velocity(generator), velocity(generator),
+                   velocity(generator)}));
+  }
+
+  std::cout << "# gcbench, powered by ::gyronimo::v" << version_major << "."
+            << version_minor << "." << version_patch
+            << " (git-commit:" << git_commit_hash << ").\n";
+  std::cout << "# args: ";
+  for (int i = 1; i < argc; i++) std::cout << argv[i] << " ";
+  std::cout << std::endl
+            << "# E_ref: " << energy_ref << " [J]"
+            << " samples: " << samples << " repeats: " << repeats << '\n';
+  std::cout << "# vars: system virtual[ns] static[ns] speedup mismatch\n";
+  auto print = [](const char* name, const std::array<double, 3>& t) {
+    std::cout << name << " " << t[0] << " " << t[1] << " " << t[0] / t[1]
+              << " " << t[2] << '\n';
+  };
+  print("guiding_centre", time_systems(gc, gc_t, gc_states, repeats));
+  print("lorentz", time_systems(lz, lz_t, lz_states, repeats));
+
+  return 0;
+}
@@ -0,0 +1,73 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @vmec_objects.hh, this file is part of ::gyronimo::
+
+// Morphism, metric, and equilibrium set up by the `VMEC` apps, either built
+// from the parser or restored from a shared-memory snapshot (-shared=name).
+
+#ifndef GYRONIMO_APPS_VMEC_OBJECTS
+#define GYRONIMO_APPS_VMEC_OBJECTS
+
+#include <gyronimo/core/snapshot.hh>
+#include <gyronimo/fields/equilibrium_vmec.hh>
+
+#include <memory>
+#include <string>
+
+//! `VMEC` objects, pointing into `shared` (if any), which is destroyed last.
+struct vmec_objects {
+  std::unique_ptr<gyronimo::snapshot> shared;
+  std::unique_ptr<gyronimo::morphism_vmec> morph;
+  std::unique_ptr<gyronimo::metric_vmec> g;
+  std::unique_ptr<gyronimo::equilibrium_vmec> veq;
+};
+
+//! Builds the objects, or restores them from `shared_name` if not empty.
+/*!
+    The snapshot is built once per node, by the first process to get there,
+    all others restoring the objects from it with no recomputation.
+*/
+inline vmec_objects build_vmec_objects(
+    const gyronimo::parser_vmec& parser,
+    const gyronimo::interpolator1d_factory& ifactory,
+    const std::string& shared_name) {
+  using namespace gyronimo;
+  vmec_objects x;
+  if (shared_name.empty()) {
+    x.morph = std::make_unique<morphism_vmec>(&parser, &ifactory);
+    x.g = std::make_unique<metric_vmec>(x.morph.get());
+    x.veq = std::make_unique<equilibrium_vmec>(x.g.get(), &ifactory);
+    return x;
+  }
+  x.shared = std::make_unique<snapshot>(shared_name, [&parser, &ifactory]() {
+    morphism_vmec morph(&parser, &ifactory);
+    metric_vmec g(&morph);
+    equilibrium_vmec veq(&g, &ifactory);
+    snapshot::writer w;
+    morph.save(w);
+    g.save(w);
+    veq.save(w);
+    return w;
+  });
+  x.morph = std::make_unique<morphism_vmec>(&parser, x.shared.get());
+  x.g = std::make_unique<metric_vmec>(x.morph.get(), x.shared.get());
+  x.veq = std::make_unique<equilibrium_vmec>(x.g.get(), x.shared.get());
+  return x;
+}
+
+#endif  // GYRONIMO_APPS_VMEC_OBJECTS
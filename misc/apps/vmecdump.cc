@@ -32,10 +32,12 @@
 #include <gyronimo/version.hh>
 
 #include <argh.h>
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <numbers>
 #include <string>
+#include <vector>
 
 using namespace gyronimo;
 
@@ -94,10 +96,10 @@ void print_rphiz(
   interpolator1d** Zmns = new interpolator1d*[vmap.xm().size()];
   for (size_t i = 0; i < vmap.xm().size(); i++) {
     std::slice u_slice(i, u_range.size(), vmap.xm().size());
-    std::valarray<double> rmnc_i = (vmap.rmnc())[u_slice];
-    Rmnc[i] = ifactory->interpolate_data(u_range, dblock_adapter(rmnc_i));
-    std::valarray<double> zmns_i = (vmap.zmns())[u_slice];
-    Zmns[i] = ifactory->interpolate_data(u_range, dblock_adapter(zmns_i));
+    Rmnc[i] = ifactory->interpolate_strided(
+        u_range, dblock_strided(vmap.rmnc(), u_slice));
+    Zmns[i] = ifactory->interpolate_strided(
+        u_range, dblock_strided(vmap.zmns(), u_slice));
   };
   double u, v, w;
   while (std::cin >> u >> v >> w) {
@@ -125,9 +127,20 @@ void print_surface(
       linspace<parser_vmec::narray_type>(0.0, 2 * std::numbers::pi, nzeta);
   auto theta_range =
       linspace<parser_vmec::narray_type>(0.0, 2 * std::numbers::pi, ntheta);
+  std::vector<double> us(ntheta * nzeta), vs(us.size()), ws(us.size());
+  for (size_t i = 0; i < ntheta; i++)
+    for (size_t j = 0; j < nzeta; j++) {
+      vs[i * nzeta + j] = zeta_range[j];
+      ws[i * nzeta + j] = theta_range[i];
+    }
+  std::vector<double> bs(us.size()), jacs(us.size());
   double u;
   while (std::cin >> u) {
     if (u <= 0.0 || u > 1.0) continue;  // ignores invalid s values.
+    std::ranges::fill(us, u);
+    if (command_line["jac"]) g.jacobian_batch({us, vs, ws}, jacs);
+    if (command_line["b"]) veq.magnitude_batch({us, vs, ws}, 0.0, bs);
+    size_t k = 0;
     for (double w : theta_range) {
       for (double v : zeta_range) {
         const IR3 q = {u, v, w};
@@ -138,8 +151,9 @@ void print_surface(
         if (command_line["r"]) std::cout << R << " ";
         if (command_line["z"]) std::cout << z << " ";
         if (command_line["phi"]) std::cout << phi << " ";
-        if (command_line["jac"]) std::cout << g.jacobian(q) << " ";
-        if (command_line["b"]) std::cout << veq.magnitude(q, 0.0) << " ";
+        if (command_line["jac"]) std::cout << jacs[k] << " ";
+        if (command_line["b"]) std::cout << bs[k] << " ";
+        k++;
         if (!command_line["python"]) std::cout << '\n';
         else if (v < 2 * std::numbers::pi) std::cout << " ";
       }
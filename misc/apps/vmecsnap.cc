@@ -0,0 +1,77 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @vmecsnap.cc, this file is part of ::gyronimo::
+
+// Command-line tool to save fully built `VMEC` objects to a binary snapshot.
+// External dependencies:
+// - [argh](https://github.com/adishavit/argh), a minimalist argument handler.
+// - [GSL](https://www.gnu.org/software/gsl), the GNU Scientific Library.
+// - [netcdf-c++4] (https://github.com/Unidata/netcdf-cxx4.git).
+
+#include <gyronimo/core/snapshot.hh>
+#include <gyronimo/fields/equilibrium_vmec.hh>
+#include <gyronimo/interpolators/cubic_gsl.hh>
+#include <gyronimo/parsers/parser_vmec.hh>
+#include <gyronimo/version.hh>
+
+#include <argh.h>
+#include <iostream>
+
+using namespace gyronimo;
+
+void print_help() {
+  std::cout << "vmecsnap, powered by ::gyronimo::v" << version_major << "."
+            << version_minor << "." << version_patch
+            << " (git-commit:" << git_commit_hash << ").\n";
+  std::string help_message =
+      "usage: vmecsnap [options] vmec_netcdf_file snapshot_file\n"
+      "builds morphism_vmec, metric_vmec, and equilibrium_vmec objects from a\n"
+      "vmec output file (cubic_gsl interpolators) and saves them to a binary\n"
+      "snapshot, to be restored by their constructors taking a snapshot.\n"
+      "options:\n"
+      "  -tolerance=\n"
+      "         Amplitude below which harmonics are dropped (default 0).\n"
+      "  -gmnc  Also save the jacobian splines from gmnc.\n";
+  std::cout << help_message;
+  std::exit(0);
+}
+
+int main(int argc, char* argv[]) {
+  auto command_line = argh::parser(argv);
+  if (command_line[{"h", "help"}]) print_help();
+  if (!command_line(2)) {  // 1st and 2nd non-option arguments: in/out files.
+    std::cout << "vmecsnap: no input or output file provided; -h for help.\n";
+    std::exit(1);
+  }
+  double tolerance;
+  command_line("tolerance", 0.0) >> tolerance;
+  cubic_gsl_factory ifactory;
+  parser_vmec parser(command_line[1], true);  // reads only what is used.
+  morphism_vmec morph(&parser, &ifactory, tolerance);
+  metric_vmec g(&morph, command_line["gmnc"] ? &ifactory : nullptr);
+  equilibrium_vmec veq(&g, &ifactory, tolerance);
+
+  snapshot::writer w;
+  morph.save(w);
+  g.save(w);
+  veq.save(w);
+  w.write(command_line[2]);
+  std::cout << "vmecsnap: " << morph.harmonics() << " + " << veq.harmonics()
+            << " harmonics saved to " << command_line[2] << ".\n";
+  return 0;
+}
@@ -36,8 +36,10 @@
 #include <boost/numeric/odeint/stepper/runge_kutta4.hpp>
 
 #include <argh.h>
+#include <vmec_objects.hh>
 #include <cmath>
 #include <iostream>
+#include <string>
 
 using namespace gyronimo;
 
@@ -61,6 +63,10 @@ void print_help() {
       "         Energy (eV) and lambda signed as v_parallel (default 1).\n"
       "  -tfinal=, -samples=\n"
       "         Time limit (lref/vref, default 1) and samples (default 512).\n"
+      "  -shared=\n"
+      "         Shared-memory snapshot name (e.g., /w7x): the equilibrium is\n"
+      "         built by the first process and restored by all others on the\n"
+      "         node; it persists until removed (rm /dev/shm/w7x).\n"
       "  Note: lambda=magnetic_moment_si*B_axis_si/energy_si.\n";
   std::cout << help_message;
   std::exit(0);
@@ -92,10 +98,10 @@ int main(int argc, char* argv[]) {
     std::exit(1);
   }
   cubic_gsl_factory ifactory;
-  parser_vmec parser(command_line[1]);
-  gyronimo::morphism_vmec morph(&parser, &ifactory);
-  gyronimo::metric_vmec g(&morph);
-  equilibrium_vmec veq(&g, &ifactory);
+  parser_vmec parser(command_line[1], true);  // reads only what is used.
+  vmec_objects vmec =
+      build_vmec_objects(parser, ifactory, command_line("shared").str());
+  const equilibrium_vmec* veq = vmec.veq.get();
 
   double flux, zeta, mass, lref, vref, theta, tfinal, charge, energy, lambda;
   command_line("flux", 0.5) >> flux;
@@ -114,8 +120,7 @@ int main(int argc, char* argv[]) {
   double energy_ref = 0.5 * codata::m_proton * mass * vref * vref;
   double energy_si = energy * codata::e;
   guiding_centre gc(
-      lref, vref, charge / mass, lambda * energy_si / energy_ref, &veq,
-      nullptr);
+      lref, vref, charge / mass, lambda * energy_si / energy_ref, veq, nullptr);
   guiding_centre::state initial_state = gc.generate_state(
       {flux, zeta, theta}, energy_si / energy_ref,
       (vpp_sign > 0 ? guiding_centre::plus : guiding_centre::minus), 0);
@@ -127,7 +132,7 @@ int main(int argc, char* argv[]) {
   for (int i = 1; i < argc; i++) std::cout << argv[i] << " ";
   std::cout << std::endl
             << "# E_ref: " << energy_ref << " [J]"
-            << " B_axis: " << veq.m_factor() << " [T]"
+            << " B_axis: " << veq->m_factor() << " [T]"
             << " mu_tilde: " << gc.mu_tilde() << '\n';
   std::cout << "# vars: t flux zeta theta E_perp/E_ref E_parallel/E_ref x y "
                "z\n";
@@ -140,7 +145,7 @@ int main(int argc, char* argv[]) {
       integration_algorithm;
   boost::numeric::odeint::integrate_const(
       integration_algorithm, odeint_adapter(&gc), initial_state, 0.0, tfinal,
-      tfinal / nsamples, orbit_observer(&veq, &gc));
+      tfinal / nsamples, orbit_observer(veq, &gc));
 
   return 0;
 }
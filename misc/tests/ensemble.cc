@@ -0,0 +1,130 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @ensemble.cc, this file is part of ::gyronimo::
+
+// Checks `ensemble` on a harmonic oscillator carrying a third component that
+// blows up in finite time if started positive: orbits of small amplitude must
+// complete, those of large amplitude must stop at the stop condition, and
+// those with a positive third component must diverge. Final states, times,
+// steps, and outcomes must match a serial `runge_kutta4` integration, orbit by
+// orbit (i.e., in the order of the initial states), whatever the number of
+// threads (including more threads than orbits).
+
+#include <gyronimo/dynamics/ensemble.hh>
+
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace gyronimo;
+
+void check(bool condition, const std::string& what) {
+  if (condition) return;
+  std::cout << "ensemble: failed " << what << ".\n";
+  std::exit(1);
+}
+
+//! Harmonic oscillator @f$(x, v)@f$ and a Riccati blow-up @f$k' = k^2@f$.
+class oscillator {
+ public:
+  using state = std::array<double, 3>;
+  state operator()(const state& s, const double& time) const {
+    return {s[1], -s[0], s[2] * s[2]};
+  };
+};
+
+using orbit = ensemble<oscillator>::orbit;
+
+//! Serial reference for a single orbit, with the semantics of `ensemble`.
+orbit reference(
+    const oscillator& f, const oscillator::state& initial, double tfinal,
+    double dt, const ensemble<oscillator>::stop_condition& stop) {
+  boost::numeric::odeint::runge_kutta4<oscillator::state> stepper;
+  odeint_adapter<oscillator> system(&f);
+  oscillator::state s = initial;
+  size_t nsteps = (size_t)std::ceil(tfinal / dt - 1.0e-9);
+  for (size_t n = 0; n < nsteps; n++) {
+    double t = n * dt;
+    stepper.do_step(system, s, t, dt);
+    if (!std::isfinite(s[0]) || !std::isfinite(s[1]) || !std::isfinite(s[2]))
+      return {s, t + dt, n + 1, ensemble<oscillator>::diverged};
+    if (stop(s, t + dt))
+      return {s, t + dt, n + 1, ensemble<oscillator>::stopped};
+  }
+  return {s, nsteps * dt, nsteps, ensemble<oscillator>::completed};
+}
+
+bool same(const orbit& x, const orbit& y) {
+  bool states = true;
+  for (size_t k = 0; k < 3; k++)
+    states = states &&
+        (x.final_state[k] == y.final_state[k] ||
+         (std::isnan(x.final_state[k]) && std::isnan(y.final_state[k])));
+  return states && x.final_time == y.final_time && x.steps == y.steps &&
+      x.status == y.status;
+}
+
+int main() {
+  oscillator f;
+  double tfinal = 10, dt = 0.01;
+  auto stop = [](const oscillator::state& s, double t) { return s[0] < -0.9; };
+
+  std::vector<oscillator::state> initial;
+  std::vector<ensemble<oscillator>::outcome> expected;
+  for (size_t i = 0; i < 37; i++) {
+    double amplitude = 0.12 + 0.05 * i, k = (i % 5 == 3 ? 0.5 + 0.1 * i : 0);
+    initial.push_back({amplitude, 0, k});
+    expected.push_back(
+        k > 0 ? ensemble<oscillator>::diverged :
+        amplitude > 0.9 ? ensemble<oscillator>::stopped :
+                          ensemble<oscillator>::completed);
+  }
+  std::vector<orbit> serial;
+  for (const oscillator::state& s : initial)
+    serial.push_back(reference(f, s, tfinal, dt, stop));
+
+  for (size_t threads : {1, 3, 8, 64}) {
+    ensemble<oscillator> parallel(&f, threads);
+    std::vector<orbit> results = parallel(initial, tfinal, dt, stop);
+    check(results.size() == initial.size(), "one result per orbit");
+    for (size_t i = 0; i < initial.size(); i++) {
+      std::string orbit_i = "orbit " + std::to_string(i) + " with " +
+          std::to_string(threads) + " threads";
+      check(results[i].status == expected[i], "outcome of " + orbit_i);
+      check(same(results[i], serial[i]), "serial result of " + orbit_i);
+    }
+  }
+
+  ensemble<oscillator> parallel(&f, 4);
+  std::vector<orbit> free = parallel({initial[0], initial[1]}, tfinal, dt);
+  check(
+      free[0].status == ensemble<oscillator>::completed &&
+          free[0].steps == 1000 && std::abs(free[0].final_time - tfinal) < dt,
+      "integration without stop condition");
+  double amplitude = initial[0][0];
+  check(
+      std::abs(free[0].final_state[0] - amplitude * std::cos(tfinal)) < 1e-9,
+      "accuracy of the oscillator");
+  check(parallel({}, tfinal, dt).empty(), "empty ensemble");
+
+  std::cout << "ensemble: ok.\n";
+  return 0;
+}
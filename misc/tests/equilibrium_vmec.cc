@@ -0,0 +1,210 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @equilibrium_vmec.cc, this file is part of ::gyronimo::
+
+// Checks that the contravariant, covariant, and magnitude series of
+// `equilibrium_vmec` are interpolated on the same (half) mesh, such that
+// @f$B^iB_i = B^2@f$ holds to roundoff at its knots. The `VMEC` file is a
+// synthetic circular torus whose half-mesh series satisfy that identity
+// exactly, any radial misalignment of the series breaking it at first order.
+// Also checks that `bundle_batch()` matches `bundle()` over several chunks and
+// that the jacobian of `metric_vmec`, taken from `gmnc`, is the same in the
+// scalar, batch, and bundle members. Optional `parser_vmec` arrays absent from
+// the file must be left empty.
+
+#include <gyronimo/fields/equilibrium_vmec.hh>
+#include <gyronimo/interpolators/cubic_gsl.hh>
+
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <netcdf>
+#include <numbers>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace gyronimo;
+
+static_assert(
+    !std::is_copy_constructible_v<parser_vmec> &&
+    !std::is_move_constructible_v<parser_vmec>);
+
+void check(bool condition, const std::string& what) {
+  if (condition) return;
+  std::cout << "equilibrium_vmec: failed " << what << ".\n";
+  std::exit(1);
+}
+
+//! Writes a two-harmonic (`m` = 0, 1) `VMEC` file with `ns` surfaces.
+void write_wout(const std::string& filename, size_t ns) {
+  constexpr double R0 = 3.0, a = 1.0, B0 = 2.0, pi = std::numbers::pi;
+  netCDF::NcFile file(filename, netCDF::NcFile::replace);
+  auto put_int = [&file](const std::string& name, int value) {
+    file.addVar(name, netCDF::ncInt).putVar(&value);
+  };
+  auto put_double = [&file](const std::string& name, double value) {
+    file.addVar(name, netCDF::ncDouble).putVar(&value);
+  };
+  for (const char* name : {"lasym__logical__", "ntor", "version_"})
+    put_int(name, 0);
+  put_int("mnmax", 2);
+  put_int("mnmax_nyq", 2);
+  put_int("mpol", 2);
+  put_int("nfp", 1);
+  put_int("ns", ns);
+  put_int("signgs", -1);
+  put_double("Aminor_p", a);
+  put_double("Rmajor_p", R0);
+  put_double("aspect", R0 / a);
+  put_double("b0", B0);
+  put_double("rbtor", R0 * B0);
+  put_double("rbtor0", R0 * B0);
+  put_double("rmax_surf", R0 + a);
+  put_double("rmin_surf", R0 - a);
+  put_double("volume_p", 2 * pi * R0 * pi * a * a);
+  put_double("zmax_surf", a);
+  for (const char* name : {"betapol", "betator", "betatotal", "betaxis"})
+    put_double(name, 0);
+
+  netCDF::NcDim radius = file.addDim("radius", ns);
+  netCDF::NcDim mn_mode = file.addDim("mn_mode", 2);
+  netCDF::NcDim mn_mode_nyq = file.addDim("mn_mode_nyq", 2);
+  std::vector<double> m = {0, 1}, n = {0, 0};
+  file.addVar("xm", netCDF::ncDouble, mn_mode).putVar(m.data());
+  file.addVar("xn", netCDF::ncDouble, mn_mode).putVar(n.data());
+  file.addVar("xm_nyq", netCDF::ncDouble, mn_mode_nyq).putVar(m.data());
+  file.addVar("xn_nyq", netCDF::ncDouble, mn_mode_nyq).putVar(n.data());
+
+  std::vector<double> rmnc(2 * ns), zmns(2 * ns), bsupvmnc(2 * ns),
+      bsupumnc(2 * ns), bsubvmnc(2 * ns), bsubumnc(2 * ns), bmnc(2 * ns),
+      bsubsmns(2 * ns, 0.0), gmnc(2 * ns);
+  for (size_t j = 0; j < ns; j++) {
+    double s = double(j) / (ns - 1), s_half = (j - 0.5) / (ns - 1);
+    rmnc[2 * j] = R0;
+    rmnc[2 * j + 1] = zmns[2 * j + 1] = a * std::sqrt(s);
+    if (j == 0) continue;  // first half-mesh row, unused by VMEC.
+    double bv = B0 / R0 * (1 - 0.3 * s_half), bu = 0.4 * (1 + s_half);
+    double b_v = B0 * R0 * (1 + 0.1 * s_half * s_half), b_u = 0.2 * s_half;
+    bsupvmnc[2 * j] = bv;
+    bsupumnc[2 * j] = bu;
+    bsubvmnc[2 * j] = b_v;
+    bsubumnc[2 * j] = b_u;
+    bmnc[2 * j] = std::sqrt(bv * b_v + bu * b_u);
+    gmnc[2 * j] = -0.5 * R0 * a * a;  // VMEC sign: minus gyronimo's.
+    gmnc[2 * j + 1] = -0.5 * a * a * a * std::sqrt(s_half);
+  }
+  std::vector<netCDF::NcDim> dims = {radius, mn_mode};
+  file.addVar("rmnc", netCDF::ncDouble, dims).putVar(rmnc.data());
+  file.addVar("zmns", netCDF::ncDouble, dims).putVar(zmns.data());
+  std::vector<netCDF::NcDim> dims_nyq = {radius, mn_mode_nyq};
+  std::vector<std::pair<const char*, const std::vector<double>*>> series = {
+      {"bsupvmnc", &bsupvmnc}, {"bsupumnc", &bsupumnc},
+      {"bsubvmnc", &bsubvmnc}, {"bsubumnc", &bsubumnc},
+      {"bsubsmns", &bsubsmns}, {"bmnc", &bmnc}, {"gmnc", &gmnc}};
+  for (auto [name, data] : series)
+    file.addVar(name, netCDF::ncDouble, dims_nyq).putVar(data->data());
+}
+
+double mismatch(const IR3& contravariant, const IR3& covariant, double b) {
+  double bb = contravariant[IR3::u] * covariant[IR3::u] +
+      contravariant[IR3::v] * covariant[IR3::v] +
+      contravariant[IR3::w] * covariant[IR3::w];
+  return std::abs(bb / (b * b) - 1);
+}
+
+int main() {
+  std::string filename = (std::filesystem::temp_directory_path() /
+      "gyronimo_check_equilibrium_vmec.nc").string();
+  write_wout(filename, 21);
+  parser_vmec vmec(filename, true);
+  check(vmec.bdotb().size() == 0 && vmec.currumnc().size() == 0,
+        "empty optional arrays absent from the file");
+  cubic_gsl_factory ifactory;
+  morphism_vmec morph(&vmec, &ifactory);
+  metric_vmec g(&morph, &ifactory);
+  equilibrium_vmec field(&g, &ifactory);
+
+  std::mt19937 generator(1);
+  std::uniform_real_distribution<double> angle(0.0, 2 * std::numbers::pi);
+  double error = 0;
+  for (double s : vmec.sgrid_half_cell())
+    for (size_t k = 0; k < 8; k++) {
+      IR3 q = {s, angle(generator), angle(generator)};
+      error = std::max(
+          error, mismatch(
+                     field.contravariant(q, 0), field.covariant(q, 0),
+                     field.magnitude(q, 0)));
+      IR3field_c1::field_bundle b = field.bundle(q, 0);
+      error = std::max(
+          error, mismatch(b.contravariant, b.covariant, b.magnitude));
+    }
+
+  std::uniform_real_distribution<double> flux(0.0, 1.0);
+  size_t n = 3 * context_vmec::chunk_size + 5;
+  std::vector<double> u(n), v(n), w(n);
+  for (size_t p = 0; p < n; p++)
+    u[p] = flux(generator), v[p] = angle(generator), w[p] = angle(generator);
+  IR3 zero = {0, 0, 0};
+  std::vector<IR3field_c1::field_bundle> batch(
+      n, {zero, zero, 0, zero, zero, zero, zero, 0, 0});
+  field.bundle_batch(IR3span(u, v, w), 0, batch);
+  std::vector<double> jacobian(n);
+  std::vector<IR3> del_jacobian(n, zero);
+  g.jacobian_batch(IR3span(u, v, w), jacobian);
+  g.del_jacobian_batch(IR3span(u, v, w), del_jacobian);
+  double batch_error = 0;
+  auto deviate = [&batch_error](double x, double y) {
+    batch_error =
+        std::max(batch_error, std::abs(x - y) / std::max(1.0, std::abs(x)));
+  };
+  for (size_t p = 0; p < n; p++) {
+    IR3 q = {u[p], v[p], w[p]};
+    IR3field_c1::field_bundle b = field.bundle(q, 0);
+    const IR3field_c1::field_bundle& c = batch[p];
+    metric_covariant::metric_bundle m = g.bundle(q, true);
+    IR3 dj = g.del_jacobian(q);
+    deviate(g.jacobian(q), jacobian[p]);
+    deviate(g.jacobian(q), m.jacobian);
+    deviate(g.jacobian(q), b.jacobian);
+    for (IR3::index i : {IR3::u, IR3::v, IR3::w}) {
+      deviate(b.contravariant[i], c.contravariant[i]);
+      deviate(b.covariant[i], c.covariant[i]);
+      deviate(b.del_magnitude[i], c.del_magnitude[i]);
+      deviate(b.curl[i], c.curl[i]);
+      deviate(dj[i], del_jacobian[p][i]);
+      deviate(dj[i], m.del_jacobian[i]);
+    }
+    deviate(b.magnitude, c.magnitude);
+    deviate(b.jacobian, c.jacobian);
+  }
+  std::filesystem::remove(filename);
+  double jacobian_bound = 1e-2;  // gmnc on the half mesh, not the geometry's.
+  check(
+      g.jacobian_mismatch() < jacobian_bound,
+      "to match gmnc with the geometric jacobian");
+  double bound = 100 * std::numeric_limits<double>::epsilon();
+  std::cout << "equilibrium_vmec: largest |B^iB_i/B^2 - 1| " << error
+            << ", largest bundle_batch() deviation " << batch_error
+            << " (bound " << bound << ").\n";
+  return (error <= bound && batch_error <= bound ? 0 : 1);
+}
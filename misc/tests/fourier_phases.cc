@@ -0,0 +1,69 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @fourier_phases.cc, this file is part of ::gyronimo::
+
+// Checks `fourier_phases` against direct `std::cos` and `std::sin` calls, on
+// `VMEC`-like harmonic sets (five field periods) of growing resolution, the
+// error having to stay within twenty times the largest mode number times the
+// machine epsilon.
+
+#include <gyronimo/core/fourier_phases.hh>
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+
+using namespace gyronimo;
+
+int main() {
+  constexpr int field_periods = 5;
+  constexpr double epsilon = std::numeric_limits<double>::epsilon();
+  std::mt19937 generator(1);
+  std::uniform_real_distribution<double> angle(-10.0, 10.0);
+  bool passed = true;
+  for (int m_max : {8, 64, 256, 1024}) {
+    int n_max = m_max / 2;
+    std::vector<double> m, n;
+    for (int i = 0; i <= m_max; i++)
+      for (int j = (i ? -n_max : 0); j <= n_max; j++) {
+        m.push_back(i);
+        n.push_back(field_periods * j);
+      }
+    fourier_phases phases(
+        fourier_phases::narray_type(m.data(), m.size()),
+        fourier_phases::narray_type(n.data(), n.size()));
+    std::vector<std::complex<double>> out(phases.size());
+    double error = 0;
+    for (size_t k = 0; k < 20; k++) {
+      double theta = angle(generator), zeta = angle(generator);
+      phases(theta, zeta, out);
+      for (size_t i = 0; i < m.size(); i++) {
+        double phase = m[i] * theta - n[i] * zeta;
+        error = std::max(error, std::abs(out[i].real() - std::cos(phase)));
+        error = std::max(error, std::abs(out[i].imag() - std::sin(phase)));
+      }
+    }
+    double mode_max = std::max(m_max, field_periods * n_max);
+    double bound = 20 * mode_max * epsilon;
+    std::cout << "fourier_phases: largest mode " << mode_max << ", error "
+              << error << " (bound " << bound << ").\n";
+    passed = passed && (error <= bound);
+  }
+  return (passed ? 0 : 1);
+}
@@ -0,0 +1,113 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @lockstep_rk4.cc, this file is part of ::gyronimo::
+
+// Checks the batched guiding-centre equations on a circular equilibrium, for a
+// batch spanning several chunks: the right-hand side of `guiding_centre::batch`
+// (both with virtual and static dispatch) must match `guiding_centre` state by
+// state, and `lockstep_rk4` steps must match serial `runge_kutta4` ones, all of
+// them bit for bit. Also checks the layout and conversions of `state_batch`.
+
+#include <gyronimo/dynamics/guiding_centre_t.hh>
+#include <gyronimo/dynamics/lockstep_rk4.hh>
+#include <gyronimo/dynamics/odeint_adapter.hh>
+#include <gyronimo/fields/equilibrium_circular.hh>
+#include <gyronimo/metrics/morphism_polar_torus.hh>
+
+#include <boost/numeric/odeint/stepper/runge_kutta4.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <numbers>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace gyronimo;
+
+void check(bool condition, const std::string& what) {
+  if (condition) return;
+  std::cout << "lockstep_rk4: failed " << what << ".\n";
+  std::exit(1);
+}
+
+bool same_bits(const guiding_centre::state& x, const guiding_centre::state& y) {
+  return std::memcmp(x.data(), y.data(), sizeof(x)) == 0;
+}
+
+int main() {
+  morphism_polar_torus morph(1.0, 3.0);
+  metric_polar_torus g(&morph);
+  auto q = [](double r) { return 1.0 + r * r; };
+  auto qprime = [](double r) { return 2.0 * r; };
+  equilibrium_circular eq(1.0, &g, q, qprime);
+  guiding_centre gc(1.0, 1.0e6, 1.0, 0.5, &eq, nullptr);
+  guiding_centre_t<equilibrium_circular> gc_t(
+      1.0, 1.0e6, 1.0, 0.5, &eq, nullptr);
+
+  std::mt19937 generator(3);
+  std::uniform_real_distribution<double> radius(0.1, 0.9),
+      angle(0.0, 2 * std::numbers::pi);
+  std::vector<guiding_centre::state> initial;
+  for (size_t i = 0; i < 150; i++)  // two full chunks and a partial one.
+    initial.push_back(gc.generate_state(
+        {radius(generator), angle(generator), angle(generator)}, 1.0,
+        (i % 2 ? guiding_centre::plus : guiding_centre::minus), 0));
+
+  guiding_centre::batch s(initial);
+  check(s.size() == initial.size(), "batch size");
+  check(s.flat_size() == 4 * initial.size(), "batch flat size");
+  for (size_t i = 0; i < initial.size(); i++) {
+    check(same_bits(s.get(i), initial[i]), "batch round trip");
+    for (size_t k = 0; k < 4; k++)
+      check(s[k][i] == initial[i][k], "batch component layout");
+  }
+
+  double time = 0.3;
+  guiding_centre::batch dsdt, dsdt_t;
+  gc(s, dsdt, time);
+  gc_t(s, dsdt_t, time);
+  check(dsdt.size() == s.size(), "right-hand side size");
+  for (size_t i = 0; i < initial.size(); i++) {
+    guiding_centre::state expected = gc(initial[i], time);
+    check(same_bits(dsdt.get(i), expected), "batched right-hand side");
+    check(same_bits(dsdt_t.get(i), expected), "static right-hand side");
+  }
+
+  boost::numeric::odeint::runge_kutta4<guiding_centre::state> stepper;
+  odeint_adapter<guiding_centre> system(&gc);
+  lockstep_rk4<guiding_centre> lockstep;
+  std::vector<guiding_centre::state> serial = initial;
+  double dt = 0.05;
+  for (size_t n = 0; n < 40; n++) {
+    double t = time + n * dt;
+    lockstep.do_step(gc, s, t, dt);
+    for (guiding_centre::state& x : serial) stepper.do_step(system, x, t, dt);
+  }
+  for (size_t i = 0; i < initial.size(); i++) {
+    check(same_bits(s.get(i), serial[i]), "lockstep_rk4 against runge_kutta4");
+    check(!same_bits(serial[i], initial[i]), "motion of the guiding centres");
+  }
+
+  s.resize(3);
+  check(s.size() == 3 && s.flat_size() == 12 && s[3][2] == 0, "batch resize");
+
+  std::cout << "lockstep_rk4: ok.\n";
+  return 0;
+}
@@ -0,0 +1,153 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @parser_castor.cc, this file is part of ::gyronimo::
+
+// Checks `parser_castor` on a synthetic ceig file: a full load must return the
+// written samples (with a1 converted from the stored -i*a1), and selective
+// loads (e.g., `vector_potential`) must return the same arrays for the kept
+// variables and empty ones for the others. The radial grid must be available
+// whatever the selection, including none, where it comes from skipped chunks.
+
+#include <gyronimo/parsers/parser_castor.hh>
+
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace gyronimo;
+
+void check(bool condition, const std::string& what) {
+  if (condition) return;
+  std::cout << "parser_castor: failed " << what << ".\n";
+  std::exit(1);
+}
+
+constexpr size_t n_psi = 7, n_harm = 3, chunks = 8;
+
+//! Sample `part` (0: real, 1: imaginary) of `chunk` at harmonic `m`, point `i`.
+double sample(size_t chunk, size_t m, size_t i, size_t part) {
+  return (chunk + 1) * std::sin(0.3 * i + m + 0.7 * part) - 0.01 * chunk;
+}
+
+//! Radial grid, non-uniform to tell its samples apart.
+double grid(size_t i) {
+  double x = double(i) / (n_psi - 1);
+  return x * x;
+}
+
+//! Writes the chunks v1, v2, v3, -i*a1, a2, a3, rho, and t, in this order.
+void write_ceig(const std::string& filename) {
+  std::ofstream file(filename);
+  file << std::scientific << std::uppercase << std::setprecision(17);
+  file << n_psi << " " << n_harm << " " << -2.0 << "\n";
+  file << 1.5e-3 << " " << -2.5e-4 << "\n";
+  for (size_t m = 0; m < n_harm; m++) file << double(m) + 1 << " ";
+  file << "\n";
+  for (size_t chunk = 0; chunk < chunks; chunk++)
+    for (size_t m = 0; m < n_harm; m++)
+      for (size_t i = 0; i < n_psi; i++)
+        file << grid(i) << " " << sample(chunk, m, i, 0) << " "
+             << sample(chunk, m, i, 1) << "\n";
+}
+
+bool same(const parser_castor::narray_type& x,
+          const parser_castor::narray_type& y) {
+  if (x.size() != y.size()) return false;
+  for (size_t k = 0; k < x.size(); k++)
+    if (x[k] != y[k]) return false;
+  return true;
+}
+
+//! Checks `x` against the samples `part` of `chunk`, times `factor`.
+bool written(
+    const parser_castor::narray_type& x, size_t chunk, size_t part,
+    double factor = 1) {
+  if (x.size() != n_psi * n_harm) return false;
+  for (size_t m = 0; m < n_harm; m++)
+    for (size_t i = 0; i < n_psi; i++)
+      if (x[i + m * n_psi] != factor * sample(chunk, m, i, part)) return false;
+  return true;
+}
+
+int main() {
+  std::string filename = (std::filesystem::temp_directory_path() /
+      ("gyronimo_check_parser_castor_" + std::to_string(::getpid()))).string();
+  write_ceig(filename);
+
+  parser_castor full(filename);
+  check(full.n_psi() == n_psi && full.n_harm() == n_harm, "sizes");
+  check(full.n_tor() == -2.0, "toroidal number");
+  check(full.eigenvalue_real() == 1.5e-3 && full.eigenvalue_imag() == -2.5e-4,
+        "eigenvalue");
+  check(full.m().size() == n_harm && full.m()[n_harm - 1] == n_harm,
+        "poloidal numbers");
+  check(full.s().size() == n_psi, "radial grid size");
+  for (size_t i = 0; i < n_psi; i++)
+    check(full.s()[i] == grid(i), "radial grid");
+  check(written(full.v1_real(), 0, 0) && written(full.v1_imag(), 0, 1) &&
+            written(full.v2_real(), 1, 0) && written(full.v2_imag(), 1, 1) &&
+            written(full.v3_real(), 2, 0) && written(full.v3_imag(), 2, 1),
+        "velocity");
+  check(written(full.a1_real(), 3, 1) && written(full.a1_imag(), 3, 0, -1),
+        "a1 from -i*a1");
+  check(written(full.a2_real(), 4, 0) && written(full.a2_imag(), 4, 1) &&
+            written(full.a3_real(), 5, 0) && written(full.a3_imag(), 5, 1),
+        "vector potential");
+  check(written(full.rho_real(), 6, 0) && written(full.rho_imag(), 6, 1) &&
+            written(full.t_real(), 7, 0) && written(full.t_imag(), 7, 1),
+        "density and temperature");
+
+  parser_castor potential(filename, parser_castor::vector_potential);
+  check(
+      same(potential.a1_real(), full.a1_real()) &&
+          same(potential.a1_imag(), full.a1_imag()) &&
+          same(potential.a2_real(), full.a2_real()) &&
+          same(potential.a2_imag(), full.a2_imag()) &&
+          same(potential.a3_real(), full.a3_real()) &&
+          same(potential.a3_imag(), full.a3_imag()),
+      "selective load of the vector potential");
+  check(
+      potential.v1_real().size() == 0 && potential.v2_imag().size() == 0 &&
+          potential.v3_real().size() == 0 && potential.rho_real().size() == 0 &&
+          potential.t_imag().size() == 0,
+      "empty arrays for skipped variables");
+  check(same(potential.s(), full.s()) && same(potential.m(), full.m()),
+        "grids of a selective load");
+
+  parser_castor temperature(filename, parser_castor::t);
+  check(same(temperature.t_real(), full.t_real()) &&
+            same(temperature.t_imag(), full.t_imag()) &&
+            temperature.a1_real().size() == 0,
+        "selective load of the last chunk");
+
+  parser_castor none(filename, 0);
+  check(same(none.s(), full.s()), "radial grid from skipped chunks");
+  check(none.a1_real().size() == 0 && none.t_real().size() == 0,
+        "empty load");
+
+  std::filesystem::remove(filename);
+  std::cout << "parser_castor: ok.\n";
+  return 0;
+}
@@ -0,0 +1,77 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @per_thread.cc, this file is part of ::gyronimo::
+
+// Checks that `per_thread` copies are private to each instance and thread,
+// and that they are released together with their instance.
+
+#include <gyronimo/core/per_thread.hh>
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace gyronimo;
+
+struct counted_t {
+  counted_t() { alive++; };
+  ~counted_t() { alive--; };
+  int value = 0;
+  static inline std::atomic<int> alive = 0;
+};
+
+void check(bool condition, const char* what) {
+  if (condition) return;
+  std::cout << "per_thread: failed " << what << ".\n";
+  std::exit(1);
+}
+
+int main() {
+  per_thread<counted_t> a, b;
+  a.local().value = 1;
+  b.local().value = 2;
+  check(a.local().value == 1 && b.local().value == 2, "instance privacy");
+
+  std::jthread([&a]() {
+    check(a.local().value == 0, "thread privacy");
+    a.local().value = 3;
+  }).join();
+  check(a.local().value == 1, "thread privacy");
+
+  per_thread<counted_t> c(a);
+  check(c.local().value == 0, "copies starting empty");
+
+  std::vector<std::unique_ptr<per_thread<counted_t>>> many;
+  for (size_t k = 0; k < 64; k++) {  // more than the per-thread table holds.
+    many.push_back(std::make_unique<per_thread<counted_t>>());
+    many.back()->local().value = k;
+  }
+  for (size_t k = 0; k < 64; k++)
+    check(many[k]->local().value == int(k), "table eviction");
+  int before = counted_t::alive;
+  many.clear();
+  check(counted_t::alive == before - 64, "release on destruction");
+  for (size_t k = 0; k < 1000; k++) per_thread<counted_t>().local();
+  check(counted_t::alive == before - 64, "release on destruction");
+
+  std::cout << "per_thread: ok.\n";
+  return 0;
+}
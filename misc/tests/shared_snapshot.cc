@@ -0,0 +1,182 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @shared_snapshot.cc, this file is part of ::gyronimo::
+
+// Checks the shared-memory `snapshot`: processes started together against the
+// same object must see the same sections, built by a single one of them. Also
+// checks failing creators: an object whose `build` throws or exits (by
+// `error()`) must be removed, and one whose creator is killed while building
+// must be taken over by the next process.
+
+#include <gyronimo/core/error.hh>
+#include <gyronimo/core/snapshot.hh>
+
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace gyronimo;
+
+void check(bool condition, const char* what) {
+  if (condition) return;
+  std::cout << "shared_snapshot: failed " << what << ".\n";
+  std::exit(1);
+}
+
+bool exists(const std::string& name) {
+  int descriptor = ::shm_open(name.c_str(), O_RDONLY, 0);
+  if (descriptor >= 0) ::close(descriptor);
+  return descriptor >= 0 || errno != ENOENT;
+}
+
+//! Runs `f` in a child process, returning its exit status.
+template<typename F>
+int in_child(const F& f) {
+  pid_t pid = ::fork();
+  if (pid == 0) {
+    f();
+    std::_Exit(0);
+  }
+  int status;
+  ::waitpid(pid, &status, 0);
+  return status;
+}
+
+snapshot::writer sections() {
+  snapshot::writer w;
+  w.add("values", std::vector<double> {1, 2, 3});
+  return w;
+}
+
+//! FNV-1a hash of the bytes of all sections in `s`.
+uint64_t hash(const snapshot& s, const std::vector<std::string>& names) {
+  uint64_t h = 14695981039346656037ull;
+  for (const std::string& name : names)
+    for (const double& x : s[name]) {
+      const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&x);
+      for (size_t k = 0; k < sizeof(x); k++)
+        h = (h ^ bytes[k]) * 1099511628211ull;
+    }
+  return h;
+}
+
+//! Maps `name` from `processes` started together, comparing what they see.
+void check_concurrent(const std::string& name, size_t processes) {
+  std::vector<double> large(1 << 16);
+  for (size_t k = 0; k < large.size(); k++) large[k] = std::sin(double(k));
+  auto build = [&large]() {
+    ::usleep(100000);  // lets the other processes start waiting.
+    snapshot::writer w;
+    w.add("large", large);
+    w.add("scalar", 42.0);
+    return w;
+  };
+  snapshot::writer reference = build();
+  std::string filename =
+      (std::filesystem::temp_directory_path() / (name.substr(1) + ".bin"))
+          .string();
+  reference.write(filename);
+  uint64_t expected = hash(snapshot(filename), {"large", "scalar"});
+  std::filesystem::remove(filename);
+
+  int channel[2];
+  check(::pipe(channel) == 0, "pipe creation");
+  std::vector<pid_t> children;
+  for (size_t k = 0; k < processes; k++) {
+    pid_t pid = ::fork();
+    if (pid == 0) {
+      bool built = false;
+      snapshot s(name, [&build, &built]() {
+        built = true;
+        return build();
+      });
+      uint64_t report[2] = {hash(s, {"large", "scalar"}), built};
+      ssize_t written = ::write(channel[1], report, sizeof(report));
+      std::_Exit(written == ssize_t(sizeof(report)) ? 0 : 1);
+    }
+    children.push_back(pid);
+  }
+  ::close(channel[1]);
+  size_t reports = 0, builders = 0;
+  uint64_t report[2];
+  while (::read(channel[0], report, sizeof(report)) ==
+         ssize_t(sizeof(report))) {
+    check(report[0] == expected, "same bytes in all processes");
+    builders += report[1];
+    reports++;
+  }
+  ::close(channel[0]);
+  for (pid_t pid : children) {
+    int status;
+    ::waitpid(pid, &status, 0);
+    check(WIFEXITED(status) && WEXITSTATUS(status) == 0, "child exit");
+  }
+  check(reports == processes, "all processes reporting");
+  check(builders == 1, "a single build");
+}
+
+int main() {
+  const std::string name = "/gyronimo_check_" + std::to_string(::getpid());
+  snapshot::remove_shared(name);
+  check_concurrent(name, 8);
+  snapshot::remove_shared(name);
+
+  try {
+    snapshot s(name, []() -> snapshot::writer {
+      throw std::runtime_error("build failed");
+    });
+    check(false, "exception propagation");
+  } catch (const std::runtime_error&) {}
+  check(!exists(name), "removal after exception");
+
+  int status = in_child([&name]() {
+    snapshot s(name, []() -> snapshot::writer {
+      error(__func__, __FILE__, __LINE__, " expected error.", 1);
+      return {};
+    });
+  });
+  check(WIFEXITED(status) && WEXITSTATUS(status) == 1, "exit by error()");
+  check(!exists(name), "removal after error()");
+
+  status = in_child([&name]() {
+    snapshot s(name, []() -> snapshot::writer {
+      ::raise(SIGKILL);
+      return {};
+    });
+  });
+  check(WIFSIGNALED(status), "creator killed");
+  check(exists(name), "abandoned object left behind");
+  snapshot s(name, sections, 5);
+  check(s["values"].size() == 3 && s["values"][2] == 3, "take over");
+
+  snapshot::remove_shared(name);
+  std::cout << "shared_snapshot: ok.\n";
+  return 0;
+}
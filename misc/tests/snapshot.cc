@@ -0,0 +1,190 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @snapshot.cc, this file is part of ::gyronimo::
+
+// Checks the file `snapshot`: sections written by a `snapshot::writer` must be
+// read back unchanged, whereas malformed files (truncated, with a bad magic
+// string or version, or with a corrupted or repeated entry in the table of
+// contents) and misuse of the writer (repeated or too long names) or reader
+// (missing sections) must abort through `error()`, checked in child processes.
+
+#include <gyronimo/core/snapshot.hh>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <numbers>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace gyronimo;
+
+void check(bool condition, const std::string& what) {
+  if (condition) return;
+  std::cout << "snapshot: failed " << what << ".\n";
+  std::exit(1);
+}
+
+//! Runs `f` in a child process, returning its exit status.
+template<typename F>
+int in_child(const F& f) {
+  pid_t pid = ::fork();
+  if (pid == 0) {
+    f();
+    std::_Exit(0);
+  }
+  int status;
+  ::waitpid(pid, &status, 0);
+  return status;
+}
+
+//! Checks that `f`, run in a child process, exits by `error()`.
+template<typename F>
+void check_aborts(const F& f, const std::string& what) {
+  int status = in_child(f);
+  check(WIFEXITED(status) && WEXITSTATUS(status) == 1, "to abort on " + what);
+}
+
+std::vector<char> read_bytes(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  return {std::istreambuf_iterator<char>(file), {}};
+}
+
+void write_bytes(const std::string& filename, const std::vector<char>& bytes) {
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  file.write(bytes.data(), bytes.size());
+}
+
+int main() {
+  std::string filename = (std::filesystem::temp_directory_path() /
+      ("gyronimo_check_snapshot_" + std::to_string(::getpid()))).string();
+  std::string corrupted = filename + ".corrupted";
+
+  std::vector<double> values(1000);
+  for (size_t k = 0; k < values.size(); k++)
+    values[k] = std::numbers::pi * k - 1.0 / (k + 1);
+  snapshot::writer w;
+  w.add("values", values);
+  w.add("scalar", -2.5);
+  w.add("empty", std::vector<double> {});
+  w.add(std::string(47, 'x'), 1.0);
+  w.write(filename);
+
+  std::vector<char> bytes = read_bytes(filename);
+  std::vector<std::byte> serialised = w.serialise();
+  check(
+      bytes.size() == serialised.size() &&
+          std::memcmp(bytes.data(), serialised.data(), bytes.size()) == 0,
+      "file matching serialise()");
+  {
+    snapshot s(filename);
+    check(
+        s.contains("values") && s.contains("scalar") && s.contains("empty") &&
+            !s.contains("missing"),
+        "section names");
+    std::span<const double> read = s["values"];
+    check(
+        read.size() == values.size() &&
+            std::memcmp(read.data(), values.data(),
+                        values.size() * sizeof(double)) == 0,
+        "round trip of an array");
+    check(s["scalar"].size() == 1 && s["scalar"][0] == -2.5,
+          "round trip of a scalar");
+    check(s["empty"].empty(), "round trip of an empty array");
+    check(s[std::string(47, 'x')].size() == 1, "longest name");
+    check(
+        reinterpret_cast<std::uintptr_t>(read.data()) % alignof(double) == 0,
+        "aligned sections");
+    check_aborts([&s]() { s["missing"]; }, "missing section");
+  }
+
+  for (size_t size : {size_t(0), size_t(16), size_t(40), bytes.size() - 8}) {
+    write_bytes(corrupted, {bytes.begin(), bytes.begin() + size});
+    check_aborts(
+        [&corrupted]() { snapshot s(corrupted); },
+        "file truncated to " + std::to_string(size) + " bytes");
+  }
+  std::vector<char> padded = bytes;
+  padded.resize(bytes.size() + 8, 0);
+  write_bytes(corrupted, padded);
+  check_aborts([&corrupted]() { snapshot s(corrupted); }, "trailing bytes");
+
+  std::vector<char> bad = bytes;
+  bad[0] = 'G';
+  write_bytes(corrupted, bad);
+  check_aborts([&corrupted]() { snapshot s(corrupted); }, "bad magic");
+
+  bad = bytes;
+  uint64_t version = snapshot::version + 1;
+  std::memcpy(bad.data() + 8, &version, sizeof(version));
+  write_bytes(corrupted, bad);
+  check_aborts([&corrupted]() { snapshot s(corrupted); }, "unknown version");
+
+  bad = bytes;
+  uint64_t sections = 1000;
+  std::memcpy(bad.data() + 16, &sections, sizeof(sections));
+  write_bytes(corrupted, bad);
+  check_aborts(
+      [&corrupted]() { snapshot s(corrupted); }, "bad number of sections");
+
+  bad = bytes;
+  uint64_t offset = bytes.size() - 8;  // first entry, past its name.
+  std::memcpy(bad.data() + 32 + 48, &offset, sizeof(offset));
+  write_bytes(corrupted, bad);
+  check_aborts(
+      [&corrupted]() { snapshot s(corrupted); }, "section past the end");
+
+  bad = bytes;
+  offset = 33;
+  std::memcpy(bad.data() + 32 + 48, &offset, sizeof(offset));
+  write_bytes(corrupted, bad);
+  check_aborts(
+      [&corrupted]() { snapshot s(corrupted); }, "misaligned section");
+
+  bad = bytes;
+  std::memcpy(bad.data() + 32 + 64, bad.data() + 32, 48);  // names.
+  write_bytes(corrupted, bad);
+  check_aborts(
+      [&corrupted]() { snapshot s(corrupted); }, "repeated entry");
+
+  check_aborts(
+      []() {
+        snapshot::writer w;
+        w.add("twice", 1.0);
+        w.add("twice", 2.0);
+      },
+      "repeated section");
+  check_aborts(
+      []() {
+        snapshot::writer w;
+        w.add(std::string(48, 'x'), 1.0);
+      },
+      "name too long");
+
+  std::filesystem::remove(filename);
+  std::filesystem::remove(corrupted);
+  std::cout << "snapshot: ok.\n";
+  return 0;
+}
@@ -0,0 +1,171 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @spline1d_array.cc, this file is part of ::gyronimo::
+
+// Checks that `spline1d_array` reproduces the values and first and second
+// derivatives of the interpolators it was built from, at random points off the
+// knots: `cubic_gsl` on a non-uniform grid and `bspline3_boost` on a uniform
+// one, built either from the objects or (in parallel) from a builder. Also
+// checks that interpolators that are not piecewise cubics with knots on the
+// grid (`bspline3_boost` on a non-uniform grid, a quartic) are rejected.
+
+#include <gyronimo/interpolators/bspline3_boost.hh>
+#include <gyronimo/interpolators/cubic_gsl.hh>
+#include <gyronimo/interpolators/spline1d_array.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace gyronimo;
+
+void check(bool condition, const std::string& what) {
+  if (condition) return;
+  std::cout << "spline1d_array: failed " << what << ".\n";
+  std::exit(1);
+}
+
+//! Runs `f` in a child process, returning its exit status.
+template<typename F>
+int in_child(const F& f) {
+  pid_t pid = ::fork();
+  if (pid == 0) {
+    f();
+    std::_Exit(0);
+  }
+  int status;
+  ::waitpid(pid, &status, 0);
+  return status;
+}
+
+//! Samples of `size` smooth functions (with different frequencies) on `x`.
+std::vector<std::vector<double>> samples(
+    const std::vector<double>& x, size_t size) {
+  std::vector<std::vector<double>> y(size, std::vector<double>(x.size()));
+  for (size_t i = 0; i < size; i++)
+    for (size_t k = 0; k < x.size(); k++)
+      y[i][k] = std::sin((i + 1) * x[k] + i) * std::exp(-x[k]) + 0.1 * i;
+  return y;
+}
+
+//! Largest deviation between `array` and `splines`, scaled by the latter.
+double deviation(
+    const spline1d_array& array,
+    const std::vector<std::unique_ptr<interpolator1d>>& splines,
+    const std::vector<double>& x) {
+  std::mt19937 generator(7);
+  std::uniform_real_distribution<double> random(x.front(), x.back());
+  double error = 0;
+  for (size_t k = 0; k < 1000; k++) {
+    double xk = random(generator);
+    if (std::find(x.begin(), x.end(), xk) != x.end()) continue;
+    size_t cell = array.cell(xk);
+    check(x[cell] <= xk && xk <= x[cell + 1], "cell search");
+    const spline1d_array::values_t& v = array(xk, cell);
+    for (size_t i = 0; i < splines.size(); i++) {
+      double expected[3] = {
+          (*splines[i])(xk), splines[i]->derivative(xk),
+          splines[i]->derivative2(xk)};
+      double single[3];
+      array.evaluate(i, cell, xk, single);
+      double fused[3] = {v.f[i], v.df[i], v.d2f[i]};
+      for (size_t d = 0; d < 3; d++) {
+        double scale = std::max(1.0, std::abs(expected[d]));
+        error = std::max(
+            {error, std::abs(fused[d] - expected[d]) / scale,
+             std::abs(single[d] - expected[d]) / scale});
+      }
+    }
+  }
+  return error;
+}
+
+//! Checks `array` built from `ifactory` on the grid `x`, in both ways.
+double check_factory(
+    const interpolator1d_factory& ifactory, const std::vector<double>& x) {
+  constexpr size_t size = 40;  // above the builder's threshold for threads.
+  std::vector<std::vector<double>> y = samples(x, size);
+  std::vector<std::unique_ptr<interpolator1d>> splines;
+  std::vector<const interpolator1d*> pointers;
+  for (size_t i = 0; i < size; i++) {
+    splines.emplace_back(
+        ifactory.interpolate_data(dblock_adapter(x), dblock_adapter(y[i])));
+    pointers.push_back(splines.back().get());
+  }
+  dblock_adapter grid(x);
+  spline1d_array from_objects(grid, pointers);
+  spline1d_array from_builder(
+      grid, size,
+      [&](size_t i) {
+        return std::unique_ptr<interpolator1d>(ifactory.interpolate_data(
+            dblock_adapter(x), dblock_adapter(y[i])));
+      },
+      true);
+  check(from_objects.size() == size && from_builder.size() == size, "size");
+  return std::max(
+      deviation(from_objects, splines, x),
+      deviation(from_builder, splines, x));
+}
+
+//! A quartic, thus not representable by cubics on any grid.
+class quartic : public interpolator1d {
+ public:
+  double operator()(double x) const override { return x * x * x * x; };
+  double derivative(double x) const override { return 4 * x * x * x; };
+  double derivative2(double x) const override { return 12 * x * x; };
+};
+
+int main() {
+  constexpr size_t points = 33;
+  std::vector<double> uniform(points), stretched(points);
+  for (size_t k = 0; k < points; k++) {
+    double t = double(k) / (points - 1);
+    uniform[k] = 3 * t;
+    stretched[k] = 3 * t * t * (1.5 - 0.5 * t);
+  }
+  double gsl_error = check_factory(cubic_gsl_factory(), stretched);
+  double boost_error = check_factory(
+      bspline3_boost_factory(bspline3_boost_factory::native), uniform);
+
+  auto rejected = [](const interpolator1d& f, const std::vector<double>& x) {
+    std::vector<const interpolator1d*> pointers = {&f};
+    dblock_adapter grid(x);
+    int status = in_child([&]() { spline1d_array array(grid, pointers); });
+    return WIFEXITED(status) && WEXITSTATUS(status) == 1;
+  };
+  std::vector<double> y = samples(stretched, 1).front();
+  std::unique_ptr<interpolator1d> boost_stretched(
+      bspline3_boost_factory(bspline3_boost_factory::native)
+          .interpolate_data(dblock_adapter(stretched), dblock_adapter(y)));
+  check(rejected(*boost_stretched, stretched), "to reject a shifted b-spline");
+  check(rejected(quartic(), uniform), "to reject a quartic");
+
+  double bound = 1e-10;  // second derivatives lose ~h^{-2} to roundoff.
+  std::cout << "spline1d_array: largest deviation from cubic_gsl "
+            << gsl_error << ", from bspline3_boost " << boost_error
+            << " (bound " << bound << ").\n";
+  return (gsl_error <= bound && boost_error <= bound ? 0 : 1);
+}
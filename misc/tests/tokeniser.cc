@@ -0,0 +1,139 @@
+// ::gyronimo:: - gyromotion for the people, by the people -
+// An object-oriented library for gyromotion applications in plasma physics.
+// Copyright (C) 2024 Paulo Rodrigues.
+
+// ::gyronimo:: is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// ::gyronimo:: is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with ::gyronimo::.  If not, see <https://www.gnu.org/licenses/>.
+
+// @tokeniser.cc, this file is part of ::gyronimo::
+
+// Checks that `tokeniser::next<double>()` returns the same bits as
+// `std::istringstream::operator>>` on tokens the latter reads whole (signs,
+// rounding, subnormals, underflow, long mantissas), also when reading a whole
+// text with `read()` and `skip()`. Tokens the stream would split or reject
+// (Fortran `D` exponents, `+-` signs, overflows, incomplete exponents, and
+// truncated input) must abort through `error()`, checked in child processes.
+
+#include <gyronimo/core/tokeniser.hh>
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace gyronimo;
+
+void check(bool condition, const std::string& what) {
+  if (condition) return;
+  std::cout << "tokeniser: failed " << what << ".\n";
+  std::exit(1);
+}
+
+//! Runs `f` in a child process, returning its exit status.
+template<typename F>
+int in_child(const F& f) {
+  pid_t pid = ::fork();
+  if (pid == 0) {
+    f();
+    std::_Exit(0);
+  }
+  int status;
+  ::waitpid(pid, &status, 0);
+  return status;
+}
+
+//! Checks that `f`, run in a child process, exits by `error()`.
+template<typename F>
+void check_aborts(const F& f, const std::string& what) {
+  int status = in_child(f);
+  check(WIFEXITED(status) && WEXITSTATUS(status) == 1, "to abort on " + what);
+}
+
+bool same_bits(double x, double y) {
+  return std::memcmp(&x, &y, sizeof(double)) == 0;
+}
+
+int main() {
+  std::vector<std::string> tokens = {
+      "0", "-0", "+0", "1", "-1", "+1.5", "0.1", "1.", "-.5", ".5e1", "1E5",
+      "1e+05", "1e-05", "-2.5E-3", "0.30000000000000004", "9007199254740993",
+      "123456789012345678901234567890", "1.7976931348623157e308",
+      "2.2250738585072011e-308", "2.2250738585072014e-308", "4.9e-324",
+      "3e-324", "2e-324", "1e-400", "-1e-400", "0.000000000000000000001",
+      "6.02214076e23", "-1.602176634e-19", "00012.5000"};
+  std::string text;
+  for (const std::string& token : tokens) {
+    std::istringstream stream(token);
+    double expected;
+    stream >> expected;
+    check(
+        !stream.fail() && stream.peek() == EOF,
+        "stream reading '" + token + "' whole");
+    tokeniser input(token);
+    double value = input.next<double>();
+    check(same_bits(value, expected), "value of '" + token + "'");
+    check(input.at_end(), "end after '" + token + "'");
+    text += token + (text.size() % 3 ? " \n" : "\t\r\n ");
+  }
+
+  std::istringstream stream(text);
+  tokeniser input(text);
+  std::vector<double> values(tokens.size() - 2);
+  input.skip(2);
+  input.read(values);
+  double expected;
+  stream >> expected >> expected;
+  for (double value : values) {
+    stream >> expected;
+    check(same_bits(value, expected), "values read from a whole text");
+  }
+  check(input.at_end(), "end of a whole text");
+  check(tokeniser(" \t\n").at_end(), "end of whitespace");
+
+  tokeniser special("inf -inf nan");
+  check(special.next<double>() == INFINITY, "inf");
+  check(special.next<double>() == -INFINITY, "-inf");
+  check(std::isnan(special.next<double>()), "nan");
+  check(tokeniser("+42").next<int>() == 42, "integer with a leading '+'");
+
+  for (std::string token :
+       {"1.0D+00", "-2.5d-3", "+-1", "++1", "+", "-", "1e", "1e+", "1e309",
+        "-1e309", "0x1p3", "1,5", "1.5.", "one"})
+    check_aborts(
+        [&token]() { tokeniser(token).next<double>(); },
+        "'" + token + "'");
+  check_aborts([]() { tokeniser("1.5").next<int>(); }, "non-integer int");
+  check_aborts(
+      []() {
+        tokeniser input("1 2");
+        input.skip(2);
+        input.next<double>();
+      },
+      "truncated input");
+  check_aborts(
+      []() {
+        std::vector<double> values(3);
+        tokeniser("1 2\n").read(values);
+      },
+      "truncated read");
+  check_aborts([]() { tokeniser("1").skip(2); }, "truncated skip");
+
+  std::cout << "tokeniser: ok.\n";
+  return 0;
+}